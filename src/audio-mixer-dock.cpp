@@ -1,21 +1,63 @@
 #include "audio-mixer-dock.hpp"
 #include "mixer-item.hpp"
 #include "order-manager.hpp"
+#include "volume-meter.hpp"
+#include "meter-ballistics.hpp"
+#include "meter-wall.hpp"
 
 #include <obs-module.h>
 #include <obs-frontend-api.h>
+#include <util/platform.h>
 
 #include <QScrollBar>
 #include <QCursor>
 #include <QStyle>
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QDragEnterEvent>
+#include <QDropEvent>
+#include <QMimeData>
+#include <QFileDialog>
+
+#include <algorithm>
+#include <cstdint>
+
+// Meter refresh interval (~60fps)
+#define METER_REFRESH_INTERVAL_MS 16
+
+// Channels shown per meter (stereo, matching OBS's compact mixer)
+#define METER_DISPLAY_CHANNELS 2
+
+// Detached strips kept around for sources that come back
+#define MIXER_ITEM_POOL_SIZE 16
+
+// Source (de)activation signals are batched over one frame
+#define SOURCE_EVENT_COALESCE_MS 16
+
+// Drop indicator thickness, and the edge band that scrolls the list while dragging
+#define DROP_INDICATOR_THICKNESS 2
+#define DRAG_SCROLL_MARGIN 24
+#define DRAG_SCROLL_STEP 16
 
 AudioMixerDock::AudioMixerDock(QWidget *parent)
 	: QFrame(parent),
+	  meterBallistics(std::make_shared<MeterBallistics>(METER_DISPLAY_CHANNELS)),
 	  orderManager(new OrderManager())
 {
 	SetupUI();
+
+	sourceEventTimer = new QTimer(this);
+	sourceEventTimer->setSingleShot(true);
+	sourceEventTimer->setInterval(SOURCE_EVENT_COALESCE_MS);
+	connect(sourceEventTimer, &QTimer::timeout, this, &AudioMixerDock::FlushSourceEvents);
+
 	ConnectSignalHandlers();
 
+	// Started once the dock is shown with at least one strip on screen
+	meterTimer = new QTimer(this);
+	meterTimer->setInterval(METER_REFRESH_INTERVAL_MS);
+	connect(meterTimer, &QTimer::timeout, this, &AudioMixerDock::RefreshMeters);
+
 	// Load saved order and preferences
 	orderManager->Load();
 
@@ -24,6 +66,10 @@ AudioMixerDock::AudioMixerDock(QWidget *parent)
 		SetVerticalLayout(true);
 	}
 
+	virtualized = orderManager->IsVirtualizedList();
+	if (orderManager->IsMeterWall())
+		SetMeterWall(true);
+
 	// Get current scene collection name
 	char *collection = obs_frontend_get_current_scene_collection();
 	if (collection) {
@@ -46,6 +92,7 @@ AudioMixerDock::~AudioMixerDock()
 {
 	DisconnectSignalHandlers();
 	ClearMixerItems();
+	ClearItemPool();
 	delete orderManager;
 }
 
@@ -72,9 +119,38 @@ void AudioMixerDock::SetupUI()
 	emptyLabel->setStyleSheet("color: gray; padding: 20px;");
 	mixerLayout->addWidget(emptyLabel);
 
+	// Strips are dropped onto the list itself; the indicator floats outside the layout
+	scrollWidget->setAcceptDrops(true);
+	dropIndicator = new QFrame(scrollWidget);
+	dropIndicator->setAutoFillBackground(true);
+	dropIndicator->setBackgroundRole(QPalette::Highlight);
+	dropIndicator->hide();
+
 	scrollArea->setWidget(scrollWidget);
 	mainLayout->addWidget(scrollArea, 1);
 
+	// Shown instead of the strip list in meter wall mode; lanes map 1:1 onto mixerItems
+	meterWall = new MeterWall(meterBallistics, this);
+	meterWall->hide();
+	mainLayout->addWidget(meterWall, 1);
+	connect(meterWall, &MeterWall::LaneSelected, this, [this](int lane, Qt::KeyboardModifiers modifiers) {
+		if (lane < static_cast<int>(mixerItems.size()))
+			OnItemSelected(mixerItems[lane], modifiers);
+	});
+	connect(meterWall, &MeterWall::LaneClicked, this, [this](int lane, Qt::KeyboardModifiers modifiers) {
+		if (lane < static_cast<int>(mixerItems.size()))
+			OnItemClicked(mixerItems[lane], modifiers);
+	});
+	connect(meterWall, &MeterWall::LaneContextMenu, this, &AudioMixerDock::OnLaneContextMenu);
+
+	// Track which strips are inside the viewport
+	connect(scrollArea->verticalScrollBar(), &QScrollBar::valueChanged, this,
+		&AudioMixerDock::ScheduleMeterVisibilityUpdate);
+	connect(scrollArea->horizontalScrollBar(), &QScrollBar::valueChanged, this,
+		&AudioMixerDock::ScheduleMeterVisibilityUpdate);
+	scrollArea->viewport()->installEventFilter(this);
+	scrollWidget->installEventFilter(this);
+
 	// Toolbar at bottom
 	toolbar = new QToolBar(this);
 	toolbar->setObjectName(QStringLiteral("mixerToolbar"));
@@ -117,10 +193,8 @@ void AudioMixerDock::ConnectSignalHandlers()
 			obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(params, "source"));
 
 			uint32_t flags = obs_source_get_output_flags(source);
-			if (flags & OBS_SOURCE_AUDIO) {
-				QMetaObject::invokeMethod(dock, "ActivateAudioSource",
-					Qt::QueuedConnection,
-					Q_ARG(OBSSource, OBSSource(source)));
+			if ((flags & OBS_SOURCE_AUDIO) && !dock->IsSourceHidden(source)) {
+				dock->QueueSourceEvent(source);
 			}
 		}, this);
 
@@ -132,9 +206,7 @@ void AudioMixerDock::ConnectSignalHandlers()
 
 			uint32_t flags = obs_source_get_output_flags(source);
 			if (flags & OBS_SOURCE_AUDIO) {
-				QMetaObject::invokeMethod(dock, "DeactivateAudioSource",
-					Qt::QueuedConnection,
-					Q_ARG(OBSSource, OBSSource(source)));
+				dock->QueueSourceEvent(source);
 			}
 		}, this);
 
@@ -144,9 +216,9 @@ void AudioMixerDock::ConnectSignalHandlers()
 			auto *dock = static_cast<AudioMixerDock *>(data);
 			obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(params, "source"));
 
-			QMetaObject::invokeMethod(dock, "ActivateAudioSource",
-				Qt::QueuedConnection,
-				Q_ARG(OBSSource, OBSSource(source)));
+			if (!dock->IsSourceHidden(source)) {
+				dock->QueueSourceEvent(source);
+			}
 		}, this);
 
 	// Audio specifically deactivated
@@ -155,9 +227,7 @@ void AudioMixerDock::ConnectSignalHandlers()
 			auto *dock = static_cast<AudioMixerDock *>(data);
 			obs_source_t *source = static_cast<obs_source_t *>(calldata_ptr(params, "source"));
 
-			QMetaObject::invokeMethod(dock, "DeactivateAudioSource",
-				Qt::QueuedConnection,
-				Q_ARG(OBSSource, OBSSource(source)));
+			dock->QueueSourceEvent(source);
 		}, this);
 
 	// Source renamed
@@ -179,10 +249,68 @@ void AudioMixerDock::DisconnectSignalHandlers()
 	signalHandlers.clear();
 }
 
+void AudioMixerDock::QueueSourceEvent(obs_source_t *source)
+{
+	bool scheduleFlush = false;
+	{
+		std::lock_guard<std::mutex> lock(pendingSourceMutex);
+
+		// Only which sources changed is kept, so activate/deactivate flapping within a frame collapses
+		if (!pendingSourceEvents.count(source))
+			pendingSourceEvents.emplace(source, OBSSource(source));
+
+		scheduleFlush = !sourceFlushQueued;
+		sourceFlushQueued = true;
+	}
+
+	// One queued call per batch, however many events arrive before it runs
+	if (scheduleFlush) {
+		QMetaObject::invokeMethod(this, [this]() {
+			sourceEventTimer->start();
+		}, Qt::QueuedConnection);
+	}
+}
+
+void AudioMixerDock::FlushSourceEvents()
+{
+	std::unordered_map<obs_source_t *, OBSSource> events;
+	{
+		std::lock_guard<std::mutex> lock(pendingSourceMutex);
+		events.swap(pendingSourceEvents);
+		sourceFlushQueued = false;
+	}
+
+	if (shuttingDown)
+		return;
+
+	// Reconcile against the source's state now rather than replaying every event; the
+	// order the signals arrived in says nothing about where a flapping source ended up
+	std::vector<OBSSource> activated;
+	for (auto &entry : events) {
+		OBSSource &source = entry.second;
+		if (obs_source_active(source) && !IsSourceHidden(source))
+			activated.push_back(std::move(source));
+		else
+			DeactivateAudioSource(source);
+	}
+
+	PopulateAudioSources(activated);
+}
+
+void AudioMixerDock::DiscardSourceEvents()
+{
+	std::lock_guard<std::mutex> lock(pendingSourceMutex);
+	pendingSourceEvents.clear();
+	sourceFlushQueued = false;
+}
+
 void AudioMixerDock::EnumerateAudioSources()
 {
+	// Collect first, then create every item in one batch
+	std::vector<OBSSource> sources;
+
 	auto enumCallback = [](void *data, obs_source_t *source) -> bool {
-		auto *dock = static_cast<AudioMixerDock *>(data);
+		auto *list = static_cast<std::vector<OBSSource> *>(data);
 
 		uint32_t flags = obs_source_get_output_flags(source);
 		if (!(flags & OBS_SOURCE_AUDIO))
@@ -191,62 +319,143 @@ void AudioMixerDock::EnumerateAudioSources()
 		if (!obs_source_active(source))
 			return true;
 
-		// Skip sources hidden in mixer
-		if (SourceMixerHidden(source))
-			return true;
-
-		dock->ActivateAudioSource(OBSSource(source));
+		list->emplace_back(source);
 		return true;
 	};
 
-	obs_enum_sources(enumCallback, this);
+	obs_enum_sources(enumCallback, &sources);
+
+	// Skip sources hidden in mixer
+	sources.erase(std::remove_if(sources.begin(), sources.end(),
+				     [this](const OBSSource &source) { return IsSourceHidden(source); }),
+		      sources.end());
+
+	PopulateAudioSources(sources);
+}
+
+void AudioMixerDock::PopulateAudioSources(const std::vector<OBSSource> &sources)
+{
+	if (sources.empty())
+		return;
+
+	// Create all items without intermediate relayouts, then sort, lay out and save once
+	scrollWidget->setUpdatesEnabled(false);
+
+	bool added = false;
+	mixerItems.reserve(mixerItems.size() + sources.size());
+	for (const OBSSource &source : sources) {
+		if (FindMixerItem(source))
+			continue;
+		CreateMixerItem(source);
+		added = true;
+	}
+
+	if (added) {
+		if (virtualized && !stripPlaceholderSize.isValid())
+			UpdateStripPlaceholders();
+		RefreshMixerLayout();
+	}
+
+	scrollWidget->setUpdatesEnabled(true);
 }
 
 void AudioMixerDock::ClearMixerItems()
 {
 	selectedItem = nullptr;
+	selectedItems.clear();
 	for (MixerItem *item : mixerItems) {
 		mixerLayout->removeWidget(item);
-		item->Cleanup(shuttingDown);
-		delete item;
+		// Collection switches refill the pool; shutdown frees everything
+		if (shuttingDown || !RecycleMixerItem(item)) {
+			item->Cleanup(shuttingDown);
+			delete item;
+		}
 	}
 	mixerItems.clear();
+	itemsBySource.clear();
+	meterWall->Clear(shuttingDown);
+
+	if (shuttingDown)
+		ClearItemPool();
 }
 
-void AudioMixerDock::RefreshMixerLayout()
+bool AudioMixerDock::RecycleMixerItem(MixerItem *item)
 {
-	// Remove all items from layout
-	for (MixerItem *item : mixerItems) {
-		mixerLayout->removeWidget(item);
-	}
+	// Strips running a menu or drag must not be rebound underneath it
+	if (itemPool.size() >= MIXER_ITEM_POOL_SIZE || item->IsContentBusy())
+		return false;
 
-	// Sort by saved order
-	std::vector<std::string> order = orderManager->GetOrder();
+	item->Unbind();
+	item->hide();
+	itemPool.push_back(item);
+	return true;
+}
 
-	std::sort(mixerItems.begin(), mixerItems.end(),
-		[&order](MixerItem *a, MixerItem *b) {
-			std::string uuidA = a->GetSourceUUID().toStdString();
-			std::string uuidB = b->GetSourceUUID().toStdString();
+void AudioMixerDock::ClearItemPool()
+{
+	for (MixerItem *item : itemPool) {
+		item->Cleanup(shuttingDown);
+		delete item;
+	}
+	itemPool.clear();
+}
 
-			auto itA = std::find(order.begin(), order.end(), uuidA);
-			auto itB = std::find(order.begin(), order.end(), uuidB);
+// Marks the longest run of entries whose ranks already increase; those widgets
+// can stay where they are and only the rest need to move
+static std::vector<bool> LongestIncreasingRun(const std::vector<size_t> &ranks)
+{
+	std::vector<size_t> tails;
+	std::vector<size_t> prev(ranks.size(), SIZE_MAX);
+
+	for (size_t i = 0; i < ranks.size(); i++) {
+		auto it = std::lower_bound(tails.begin(), tails.end(), ranks[i],
+			[&ranks](size_t idx, size_t rank) { return ranks[idx] < rank; });
+		if (it != tails.begin())
+			prev[i] = *(it - 1);
+		if (it == tails.end())
+			tails.push_back(i);
+		else
+			*it = i;
+	}
 
-			// Items not in order go to end, sorted alphabetically
-			if (itA == order.end() && itB == order.end()) {
-				return a->GetSourceName() < b->GetSourceName();
-			}
-			if (itA == order.end()) return false;
-			if (itB == order.end()) return true;
+	std::vector<bool> keep(ranks.size(), false);
+	for (size_t i = tails.empty() ? SIZE_MAX : tails.back(); i != SIZE_MAX; i = prev[i]) {
+		keep[i] = true;
+	}
+	return keep;
+}
 
-			return itA < itB;
-		});
+void AudioMixerDock::RefreshMixerLayout()
+{
+	// Sort by saved order: place each item directly at its indexed position
+	std::vector<MixerItem *> ordered(orderManager->GetOrderSize(), nullptr);
+	std::vector<std::pair<QString, MixerItem *>> unordered;
 
-	// Re-add in sorted order
 	for (MixerItem *item : mixerItems) {
-		mixerLayout->addWidget(item);
+		int pos = orderManager->GetPosition(item->GetSourceUUID());
+		if (pos >= 0 && !ordered[pos])
+			ordered[pos] = item;
+		else
+			unordered.emplace_back(item->GetSourceName(), item);
 	}
 
-	// Save order immediately
+	// Items not in order go to end, sorted alphabetically
+	std::sort(unordered.begin(), unordered.end(),
+		  [](const auto &a, const auto &b) { return a.first < b.first; });
+
+	mixerItems.clear();
+	for (MixerItem *item : ordered) {
+		if (item)
+			mixerItems.push_back(item);
+	}
+	for (const auto &entry : unordered) {
+		mixerItems.push_back(entry.second);
+	}
+
+	// Move only the widgets whose position changed
+	ApplyLayoutOrder();
+
+	// Queue a save if anything changed
 	orderManager->Save();
 
 	// Update empty state
@@ -255,132 +464,656 @@ void AudioMixerDock::RefreshMixerLayout()
 	UpdateToolbarButtons();
 }
 
+void AudioMixerDock::ApplyLayoutOrder()
+{
+	// The wall mirrors the list order
+	SyncMeterWall();
+
+	// Items follow the empty label in the layout
+	const int offset = mixerLayout->indexOf(emptyLabel) + 1;
+
+	std::unordered_map<MixerItem *, size_t> rank;
+	rank.reserve(mixerItems.size());
+	for (size_t i = 0; i < mixerItems.size(); i++) {
+		rank.emplace(mixerItems[i], i);
+	}
+
+	// Current widget order, as new ranks
+	std::vector<MixerItem *> current;
+	std::vector<size_t> currentRanks;
+	for (int i = offset; i < mixerLayout->count(); i++) {
+		auto *item = qobject_cast<MixerItem *>(mixerLayout->itemAt(i)->widget());
+		auto it = item ? rank.find(item) : rank.end();
+		if (it == rank.end())
+			continue;
+		current.push_back(item);
+		currentRanks.push_back(it->second);
+	}
+
+	// Widgets on the longest increasing run keep their place
+	std::vector<bool> keep = LongestIncreasingRun(currentRanks);
+	std::unordered_map<MixerItem *, bool> staying;
+	staying.reserve(current.size());
+	for (size_t i = 0; i < current.size(); i++) {
+		staying.emplace(current[i], keep[i]);
+	}
+
+	if (current.size() == mixerItems.size() &&
+	    std::all_of(keep.begin(), keep.end(), [](bool k) { return k; }))
+		return;
+
+	// Move only what changed, in one repaint-free window
+	const bool updatesWereEnabled = scrollWidget->updatesEnabled();
+	if (updatesWereEnabled)
+		scrollWidget->setUpdatesEnabled(false);
+
+	for (size_t i = 0; i < current.size(); i++) {
+		if (!keep[i])
+			mixerLayout->removeWidget(current[i]);
+	}
+
+	// Inserting in final order puts every moved or new item at its exact index
+	for (size_t i = 0; i < mixerItems.size(); i++) {
+		auto it = staying.find(mixerItems[i]);
+		if (it == staying.end() || !it->second)
+			mixerLayout->insertWidget(offset + static_cast<int>(i), mixerItems[i]);
+	}
+
+	if (updatesWereEnabled)
+		scrollWidget->setUpdatesEnabled(true);
+}
+
 void AudioMixerDock::UpdateToolbarButtons()
 {
-	if (!selectedItem) {
-		upAction->setEnabled(false);
-		downAction->setEnabled(false);
-	} else {
-		int index = GetItemIndex(selectedItem);
-		upAction->setEnabled(index > 0);
-		downAction->setEnabled(index >= 0 && index < static_cast<int>(mixerItems.size()) - 1);
+	// The selection can move while any selected strip has an unselected neighbour that way
+	bool canMoveUp = false;
+	bool canMoveDown = false;
+	if (!selectedItems.empty()) {
+		for (size_t i = 0; i + 1 < mixerItems.size() && !(canMoveUp && canMoveDown); i++) {
+			bool current = mixerItems[i]->IsSelected();
+			bool next = mixerItems[i + 1]->IsSelected();
+			canMoveUp = canMoveUp || (next && !current);
+			canMoveDown = canMoveDown || (current && !next);
+		}
 	}
 
-	// Refresh toolbar styling after enabling/disabling actions
-	for (QAction *action : toolbar->actions()) {
+	// Refresh toolbar styling only for buttons whose enabled state actually flipped
+	auto setActionEnabled = [this](QAction *action, bool enabled) {
+		if (action->isEnabled() == enabled)
+			return;
+		action->setEnabled(enabled);
 		QWidget *widget = toolbar->widgetForAction(action);
 		if (widget) {
 			widget->style()->unpolish(widget);
 			widget->style()->polish(widget);
 		}
+	};
+	setActionEnabled(upAction, canMoveUp);
+	setActionEnabled(downAction, canMoveDown);
+}
+
+void AudioMixerDock::SetItemSelected(MixerItem *item, bool selected)
+{
+	if (selected)
+		selectedItems.insert(item);
+	else
+		selectedItems.erase(item);
+	item->SetSelected(selected);
+	meterWall->SetLaneSelected(item->GetSource(), selected);
+}
+
+void AudioMixerDock::ClearSelection()
+{
+	for (MixerItem *item : selectedItems) {
+		item->SetSelected(false);
+	}
+	selectedItems.clear();
+	selectedItem = nullptr;
+	meterWall->ClearSelection();
+}
+
+std::vector<MixerItem *> AudioMixerDock::GetSelectedItems() const
+{
+	// In list order
+	std::vector<MixerItem *> items;
+	items.reserve(selectedItems.size());
+	for (MixerItem *item : mixerItems) {
+		if (item->IsSelected())
+			items.push_back(item);
 	}
+	return items;
 }
 
 void AudioMixerDock::SelectItem(MixerItem *item)
 {
-	if (selectedItem == item)
+	if (selectedItem == item && selectedItems.size() == (item ? 1u : 0u))
 		return;
 
-	// Deselect previous
-	if (selectedItem) {
-		selectedItem->SetSelected(false);
-	}
-
-	// Select new
+	// Single selection replaces whatever was selected
+	ClearSelection();
 	selectedItem = item;
 	if (selectedItem) {
-		selectedItem->SetSelected(true);
+		SetItemSelected(selectedItem, true);
 	}
 
 	UpdateToolbarButtons();
 }
 
-void AudioMixerDock::OnItemSelected(MixerItem *item)
+void AudioMixerDock::OnItemSelected(MixerItem *item, Qt::KeyboardModifiers modifiers)
 {
+	if (modifiers & Qt::ControlModifier) {
+		// Toggle, and make it the anchor for a following Shift range
+		SetItemSelected(item, !item->IsSelected());
+		selectedItem = item;
+		UpdateToolbarButtons();
+		return;
+	}
+
+	if ((modifiers & Qt::ShiftModifier) && selectedItem) {
+		int anchor = GetItemIndex(selectedItem);
+		int index = GetItemIndex(item);
+		if (anchor >= 0 && index >= 0) {
+			MixerItem *anchorItem = selectedItem;
+			ClearSelection();
+			for (int i = std::min(anchor, index); i <= std::max(anchor, index); i++) {
+				SetItemSelected(mixerItems[i], true);
+			}
+			selectedItem = anchorItem;
+			UpdateToolbarButtons();
+			return;
+		}
+	}
+
+	// Pressing a strip inside a multi-selection keeps it so the block can be dragged;
+	// the click (release without drag) collapses it
+	if (item->IsSelected() && selectedItems.size() > 1)
+		return;
+
 	SelectItem(item);
 }
 
+void AudioMixerDock::OnItemClicked(MixerItem *item, Qt::KeyboardModifiers modifiers)
+{
+	if (!(modifiers & (Qt::ControlModifier | Qt::ShiftModifier)) && selectedItems.size() > 1)
+		SelectItem(item);
+}
+
 void AudioMixerDock::OnMoveUpClicked()
 {
-	if (!selectedItem)
+	MoveSelection(-1);
+}
+
+void AudioMixerDock::OnMoveDownClicked()
+{
+	MoveSelection(1);
+}
+
+void AudioMixerDock::OnLaneContextMenu(int lane)
+{
+	// Right-clicking an unselected lane acts on that lane alone
+	if (lane >= 0 && lane < static_cast<int>(mixerItems.size()) && !mixerItems[lane]->IsSelected())
+		SelectItem(mixerItems[lane]);
+
+	ShowContextMenu(QPoint());
+}
+
+void AudioMixerDock::MoveSelection(int direction)
+{
+	if (selectedItems.empty())
 		return;
 
-	int index = GetItemIndex(selectedItem);
-	if (index <= 0)
+	// Each selected strip swaps with the unselected neighbour on that side, so
+	// contiguous runs move as a block and the ends stay put
+	std::vector<MixerItem *> order = mixerItems;
+	if (direction < 0) {
+		for (size_t i = 1; i < order.size(); i++) {
+			if (order[i]->IsSelected() && !order[i - 1]->IsSelected())
+				std::swap(order[i], order[i - 1]);
+		}
+	} else {
+		for (size_t i = order.size(); i-- > 1;) {
+			if (order[i - 1]->IsSelected() && !order[i]->IsSelected())
+				std::swap(order[i - 1], order[i]);
+		}
+	}
+
+	ApplyItemOrder(order);
+}
+
+void AudioMixerDock::ApplyItemOrder(const std::vector<MixerItem *> &order)
+{
+	if (order == mixerItems)
 		return;
 
-	// Get the UUIDs of the two items being swapped
-	std::string uuidSelected = selectedItem->GetSourceUUID().toStdString();
-	std::string uuidAbove = mixerItems[index - 1]->GetSourceUUID().toStdString();
+	mixerItems = order;
+
+	// One order update: permute the visible strips within the slots they already hold
+	std::vector<std::string> uuids;
+	uuids.reserve(mixerItems.size());
+	for (MixerItem *mi : mixerItems) {
+		uuids.push_back(mi->GetSourceUUID());
+	}
+	if (!orderManager->ReorderSubset(uuids)) {
+		// Scene has no saved order or items missing - build from current visible items
+		orderManager->SetOrder(uuids);
+	}
+
+	// One relayout of just the strips that moved, and one save
+	ApplyLayoutOrder();
+	orderManager->Save();
+
+	UpdateToolbarButtons();
+}
+
+void AudioMixerDock::SetSelectionMuted(bool muted)
+{
+	for (MixerItem *item : GetSelectedItems()) {
+		obs_source_set_muted(item->GetSource(), muted);
+	}
+}
+
+void AudioMixerDock::HideSelection()
+{
+	std::vector<OBSSource> sources;
+	for (MixerItem *item : GetSelectedItems()) {
+		sources.emplace_back(item->GetSource());
+	}
+	HideSources(sources);
+}
+
+void AudioMixerDock::RefreshMeters()
+{
+	uint64_t ts = os_gettime_ns();
+	float timeSinceLastRefresh = lastMeterRefreshTime ? float((ts - lastMeterRefreshTime) * 0.000000001)
+							   : METER_REFRESH_INTERVAL_MS * 0.001f;
+	lastMeterRefreshTime = ts;
+
+	if (meterWallMode) {
+		meterWall->PullLevels(ts);
+	} else {
+		for (MixerItem *item : mixerItems) {
+			VolumeMeter *meter = item->GetVolumeMeter();
+			if (meter && item->IsMeteringActive())
+				meter->pullLevels(ts);
+		}
+	}
+
+	// One batched pass over every meter's channels
+	meterBallistics->process(timeSinceLastRefresh);
+
+	// Only repaint meters whose displayed state actually changed
+	if (meterWallMode) {
+		meterWall->Refresh();
+	} else {
+		for (MixerItem *item : mixerItems) {
+			VolumeMeter *meter = item->GetVolumeMeter();
+			if (meter && item->IsMeteringActive() && meter->refresh())
+				meter->update();
+		}
+	}
+}
+
+void AudioMixerDock::showEvent(QShowEvent *event)
+{
+	QFrame::showEvent(event);
+	dockShown = true;
+	ScheduleMeterVisibilityUpdate();
+}
+
+void AudioMixerDock::hideEvent(QHideEvent *event)
+{
+	QFrame::hideEvent(event);
+
+	// Also delivered (spontaneously) when the main window is minimized
+	dockShown = false;
+	UpdateMeterVisibility();
+}
+
+bool AudioMixerDock::eventFilter(QObject *obj, QEvent *event)
+{
+	if (obj == scrollArea->viewport() || obj == scrollWidget) {
+		switch (event->type()) {
+		case QEvent::Resize:
+		case QEvent::LayoutRequest:
+			ScheduleMeterVisibilityUpdate();
+			break;
+		case QEvent::DragEnter:
+		case QEvent::DragMove:
+		case QEvent::DragLeave:
+		case QEvent::Drop:
+			if (obj == scrollWidget && HandleDragEvent(event))
+				return true;
+			break;
+		default:
+			break;
+		}
+	}
+	return QFrame::eventFilter(obj, event);
+}
+
+bool AudioMixerDock::HandleDragEvent(QEvent *event)
+{
+	if (event->type() == QEvent::DragLeave) {
+		dropIndicator->hide();
+		return true;
+	}
+
+	auto *dropEvent = static_cast<QDropEvent *>(event);
+	if (!dropEvent->mimeData()->hasFormat(MIXER_ITEM_MIME_TYPE))
+		return false;
+
+	QPoint pos = dropEvent->position().toPoint();
+	int gap = DropIndexAt(pos);
+
+	switch (event->type()) {
+	case QEvent::DragEnter:
+	case QEvent::DragMove:
+		AutoScrollForDrag(pos);
+		ShowDropIndicator(gap);
+		dropEvent->setDropAction(Qt::MoveAction);
+		dropEvent->accept();
+		return true;
+	case QEvent::Drop: {
+		dropIndicator->hide();
+
+		std::string uuid = dropEvent->mimeData()->data(MIXER_ITEM_MIME_TYPE).toStdString();
+		auto it = std::find_if(mixerItems.begin(), mixerItems.end(),
+				       [&uuid](MixerItem *item) { return item->GetSourceUUID() == uuid; });
+		if (it != mixerItems.end()) {
+			// Dragging a selected strip carries the whole selection
+			if ((*it)->IsSelected() && selectedItems.size() > 1)
+				MoveItems(GetSelectedItems(), gap);
+			else
+				MoveItem(static_cast<int>(it - mixerItems.begin()), gap);
+		}
+
+		dropEvent->setDropAction(Qt::MoveAction);
+		dropEvent->accept();
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+int AudioMixerDock::DropIndexAt(const QPoint &pos) const
+{
+	// Strips are laid out in list order, so the gap is found by bisecting their centres
+	auto it = std::partition_point(mixerItems.begin(), mixerItems.end(), [this, &pos](MixerItem *item) {
+		QPoint center = item->geometry().center();
+		return vertical ? center.x() < pos.x() : center.y() < pos.y();
+	});
+	return static_cast<int>(it - mixerItems.begin());
+}
 
-	// Swap in our local list for immediate UI feedback
-	std::swap(mixerItems[index], mixerItems[index - 1]);
+void AudioMixerDock::ShowDropIndicator(int index)
+{
+	if (mixerItems.empty()) {
+		dropIndicator->hide();
+		return;
+	}
 
-	// Get the scene's saved order
-	std::vector<std::string> order = orderManager->GetOrder();
-	auto itSelected = std::find(order.begin(), order.end(), uuidSelected);
-	auto itAbove = std::find(order.begin(), order.end(), uuidAbove);
+	// Centre the line in the spacing before the strip at index, or after the last one
+	const int half = mixerLayout->spacing() / 2;
+	const bool atEnd = index >= static_cast<int>(mixerItems.size());
+	QRect geometry = mixerItems[atEnd ? mixerItems.size() - 1 : index]->geometry();
 
-	if (itSelected != order.end() && itAbove != order.end()) {
-		// Both found in order, swap their positions
-		std::iter_swap(itSelected, itAbove);
+	if (vertical) {
+		int x = atEnd ? geometry.right() + 1 + half : geometry.left() - half;
+		dropIndicator->setGeometry(x - DROP_INDICATOR_THICKNESS / 2, geometry.top(), DROP_INDICATOR_THICKNESS,
+					   geometry.height());
 	} else {
+		int y = atEnd ? geometry.bottom() + 1 + half : geometry.top() - half;
+		dropIndicator->setGeometry(geometry.left(), y - DROP_INDICATOR_THICKNESS / 2, geometry.width(),
+					   DROP_INDICATOR_THICKNESS);
+	}
+
+	dropIndicator->raise();
+	dropIndicator->show();
+}
+
+void AudioMixerDock::AutoScrollForDrag(const QPoint &pos)
+{
+	QWidget *viewport = scrollArea->viewport();
+	QPoint viewportPos = scrollWidget->mapTo(viewport, pos);
+	QScrollBar *bar = vertical ? scrollArea->horizontalScrollBar() : scrollArea->verticalScrollBar();
+	int coord = vertical ? viewportPos.x() : viewportPos.y();
+	int extent = vertical ? viewport->width() : viewport->height();
+
+	if (coord < DRAG_SCROLL_MARGIN)
+		bar->setValue(bar->value() - DRAG_SCROLL_STEP);
+	else if (coord > extent - DRAG_SCROLL_MARGIN)
+		bar->setValue(bar->value() + DRAG_SCROLL_STEP);
+}
+
+void AudioMixerDock::MoveItem(int from, int gap)
+{
+	// Gap is the insertion point in the current list; account for the item leaving it
+	int target = gap > from ? gap - 1 : gap;
+	if (from < 0 || target == from)
+		return;
+
+	MixerItem *item = mixerItems[from];
+	mixerItems.erase(mixerItems.begin() + from);
+	mixerItems.insert(mixerItems.begin() + target, item);
+
+	// Splice the saved order next to the strip's new visible neighbour
+	const std::string &uuid = item->GetSourceUUID();
+	int oldPos = orderManager->GetPosition(uuid);
+	bool hasNext = target + 1 < static_cast<int>(mixerItems.size());
+	MixerItem *anchor = mixerItems[hasNext ? target + 1 : target - 1];
+	int anchorPos = orderManager->GetPosition(anchor->GetSourceUUID());
+
+	bool moved = false;
+	if (oldPos >= 0 && anchorPos >= 0) {
+		int newPos = hasNext ? (oldPos < anchorPos ? anchorPos - 1 : anchorPos)
+				     : (oldPos < anchorPos ? anchorPos : anchorPos + 1);
+		moved = orderManager->MoveSource(uuid, static_cast<size_t>(newPos));
+	}
+	if (!moved) {
 		// Scene has no saved order or items missing - build from current visible items
-		order.clear();
+		std::vector<std::string> order;
+		order.reserve(mixerItems.size());
 		for (MixerItem *mi : mixerItems) {
-			order.push_back(mi->GetSourceUUID().toStdString());
+			order.push_back(mi->GetSourceUUID());
 		}
+		orderManager->SetOrder(order);
 	}
-	orderManager->SetOrder(order);
 
-	// Refresh layout (also saves)
-	RefreshMixerLayout();
+	// Only the dropped strip changes position in the layout
+	ApplyLayoutOrder();
+	orderManager->Save();
+
+	SelectItem(item);
+	UpdateToolbarButtons();
 }
 
-void AudioMixerDock::OnMoveDownClicked()
+void AudioMixerDock::MoveItems(const std::vector<MixerItem *> &block, int gap)
 {
-	if (!selectedItem)
+	// Strips outside the block keep their relative order around the gap
+	std::unordered_set<MixerItem *> moving(block.begin(), block.end());
+	std::vector<MixerItem *> order;
+	order.reserve(mixerItems.size());
+
+	for (int i = 0; i < gap && i < static_cast<int>(mixerItems.size()); i++) {
+		if (!moving.count(mixerItems[i]))
+			order.push_back(mixerItems[i]);
+	}
+	order.insert(order.end(), block.begin(), block.end());
+	for (int i = std::max(gap, 0); i < static_cast<int>(mixerItems.size()); i++) {
+		if (!moving.count(mixerItems[i]))
+			order.push_back(mixerItems[i]);
+	}
+
+	ApplyItemOrder(order);
+}
+
+void AudioMixerDock::ScheduleMeterVisibilityUpdate()
+{
+	if (meterVisibilityUpdatePending)
+		return;
+
+	// Deferred so layout geometry has settled before strips are tested
+	meterVisibilityUpdatePending = true;
+	QMetaObject::invokeMethod(this, [this]() { UpdateMeterVisibility(); }, Qt::QueuedConnection);
+}
+
+void AudioMixerDock::UpdateMeterVisibility()
+{
+	meterVisibilityUpdatePending = false;
+
+	if (shuttingDown)
+		return;
+
+	// Make sure strip geometry reflects any pending layout changes
+	mixerLayout->activate();
+
+	bool dockVisible = dockShown && isVisible();
+	QRect viewportRect(-scrollWidget->pos(), scrollArea->viewport()->size());
+
+	// Virtualized lists build strips one viewport ahead and drop them two viewports out
+	int w = viewportRect.width();
+	int h = viewportRect.height();
+	QRect createRect = viewportRect.adjusted(-w, -h, w, h);
+	QRect keepRect = viewportRect.adjusted(-2 * w, -2 * h, 2 * w, 2 * h);
+
+	bool anyActive = false;
+	if (meterWallMode) {
+		// Strips are empty shells while the wall meters every source itself
+		for (MixerItem *item : mixerItems) {
+			if (item->HasContent())
+				item->ReleaseContent();
+			item->SetMeteringActive(false);
+		}
+		meterWall->SetMeteringActive(dockVisible);
+		anyActive = meterWall->IsMeteringActive();
+	} else {
+		for (MixerItem *item : mixerItems) {
+			if (virtualized && dockVisible) {
+				QRect geometry = item->geometry();
+				if (!item->HasContent() && geometry.intersects(createRect))
+					item->CreateContent();
+				else if (item->HasContent() && !geometry.intersects(keepRect))
+					item->ReleaseContent();
+			}
+
+			bool onScreen = dockVisible && item->geometry().intersects(viewportRect);
+			item->SetMeteringActive(onScreen);
+			anyActive = anyActive || onScreen;
+		}
+	}
+
+	if (anyActive && !meterTimer->isActive()) {
+		lastMeterRefreshTime = 0;
+		meterTimer->start();
+	} else if (!anyActive && meterTimer->isActive()) {
+		meterTimer->stop();
+	}
+}
+
+void AudioMixerDock::UpdateStripPlaceholders()
+{
+	if (!virtualized || meterWallMode || mixerItems.empty())
 		return;
 
-	int index = GetItemIndex(selectedItem);
-	if (index < 0 || index >= static_cast<int>(mixerItems.size()) - 1)
+	// All strips share one footprint; measure it from a strip that has content
+	MixerItem *sample = nullptr;
+	for (MixerItem *item : mixerItems) {
+		if (item->HasContent()) {
+			sample = item;
+			break;
+		}
+	}
+	if (!sample) {
+		sample = mixerItems.front();
+		sample->CreateContent();
+	}
+
+	stripPlaceholderSize = sample->sizeHint();
+	for (MixerItem *item : mixerItems) {
+		item->SetPlaceholderSize(stripPlaceholderSize);
+	}
+}
+
+void AudioMixerDock::SetVirtualizedList(bool enabled)
+{
+	if (virtualized == enabled)
 		return;
 
-	// Get the UUIDs of the two items being swapped
-	std::string uuidSelected = selectedItem->GetSourceUUID().toStdString();
-	std::string uuidBelow = mixerItems[index + 1]->GetSourceUUID().toStdString();
+	virtualized = enabled;
+
+	if (virtualized) {
+		UpdateStripPlaceholders();
+	} else if (!meterWallMode) {
+		for (MixerItem *item : mixerItems) {
+			item->CreateContent();
+		}
+	}
+	ScheduleMeterVisibilityUpdate();
+
+	// Save preference
+	orderManager->SetVirtualizedList(virtualized);
+	orderManager->Save();
+}
 
-	// Swap in our local list for immediate UI feedback
-	std::swap(mixerItems[index], mixerItems[index + 1]);
+void AudioMixerDock::SetMeterWall(bool enabled)
+{
+	if (meterWallMode == enabled)
+		return;
 
-	// Get the scene's saved order
-	std::vector<std::string> order = orderManager->GetOrder();
-	auto itSelected = std::find(order.begin(), order.end(), uuidSelected);
-	auto itBelow = std::find(order.begin(), order.end(), uuidBelow);
+	meterWallMode = enabled;
+	scrollArea->setVisible(!meterWallMode);
+	meterWall->setVisible(meterWallMode);
 
-	if (itSelected != order.end() && itBelow != order.end()) {
-		// Both found in order, swap their positions
-		std::iter_swap(itSelected, itBelow);
+	if (meterWallMode) {
+		// Strips give up their widgets and OBS handles; the wall takes over metering
+		for (MixerItem *item : mixerItems) {
+			item->ReleaseContent();
+		}
+		SyncMeterWall();
 	} else {
-		// Scene has no saved order or items missing - build from current visible items
-		order.clear();
-		for (MixerItem *mi : mixerItems) {
-			order.push_back(mi->GetSourceUUID().toStdString());
+		meterWall->SetMeteringActive(false);
+		meterWall->Clear();
+		if (virtualized) {
+			UpdateStripPlaceholders();
+		} else {
+			for (MixerItem *item : mixerItems) {
+				item->CreateContent();
+			}
 		}
 	}
-	orderManager->SetOrder(order);
+	ScheduleMeterVisibilityUpdate();
 
-	// Refresh layout (also saves)
-	RefreshMixerLayout();
+	// Save preference
+	orderManager->SetMeterWall(meterWallMode);
+	orderManager->Save();
 }
 
-MixerItem *AudioMixerDock::FindMixerItem(obs_source_t *source)
+void AudioMixerDock::SyncMeterWall()
 {
+	if (!meterWallMode)
+		return;
+
+	std::vector<OBSSource> sources;
+	sources.reserve(mixerItems.size());
 	for (MixerItem *item : mixerItems) {
-		if (item->GetSource() == source)
-			return item;
+		sources.emplace_back(item->GetSource());
+	}
+	meterWall->SetSources(sources);
+
+	// Lanes that were already shown keep their flags; new ones start unselected
+	for (MixerItem *item : selectedItems) {
+		meterWall->SetLaneSelected(item->GetSource(), true);
 	}
-	return nullptr;
+
+	// Metering starts once the wall has lanes on screen
+	ScheduleMeterVisibilityUpdate();
+}
+
+MixerItem *AudioMixerDock::FindMixerItem(obs_source_t *source)
+{
+	auto it = itemsBySource.find(source);
+	return it != itemsBySource.end() ? it->second : nullptr;
 }
 
 int AudioMixerDock::GetItemIndex(MixerItem *item)
@@ -403,60 +1136,96 @@ void AudioMixerDock::ActivateAudioSource(OBSSource source)
 		return;
 
 	// Skip sources hidden in mixer
-	if (SourceMixerHidden(source))
+	if (IsSourceHidden(source))
 		return;
 
-	// Create mixer item
-	MixerItem *item = new MixerItem(source, vertical, scrollWidget);
-
-	// Connect signals
-	connect(item, &MixerItem::Selected, this, &AudioMixerDock::OnItemSelected);
-	connect(item, &MixerItem::HideRequested, this, [this](MixerItem *item) {
-		// Capture the source before any cleanup happens
-		OBSSource source = OBSSource(item->GetSource());
-		// Defer the hide operation to ensure all signal handlers complete first
-		QMetaObject::invokeMethod(this, [this, source]() {
-			HideSource(source);
-		}, Qt::QueuedConnection);
-	});
+	CreateMixerItem(source);
 
-	// Add to list and order manager
-	mixerItems.push_back(item);
-	orderManager->AddSource(item->GetSourceUUID().toStdString());
+	if (virtualized && !stripPlaceholderSize.isValid())
+		UpdateStripPlaceholders();
 
 	// Refresh layout
 	RefreshMixerLayout();
 }
 
+MixerItem *AudioMixerDock::CreateMixerItem(OBSSource source)
+{
+	// Create (or rebind a pooled) mixer item without laying it out; virtualized lists start
+	// with an empty placeholder (callers measure the footprint via UpdateStripPlaceholders if unknown)
+	MixerItem *item = nullptr;
+	if (!itemPool.empty()) {
+		item = itemPool.back();
+		itemPool.pop_back();
+		item->Rebind(source, vertical);
+		if (!StripContentDeferred())
+			item->CreateContent();
+		item->show();
+	} else {
+		item = new MixerItem(source, meterBallistics, vertical, StripContentDeferred(), scrollWidget);
+
+		// Connect signals
+		connect(item, &MixerItem::Selected, this, &AudioMixerDock::OnItemSelected);
+		connect(item, &MixerItem::Clicked, this, &AudioMixerDock::OnItemClicked);
+		connect(item, &MixerItem::HideRequested, this, [this](MixerItem *item) {
+			// Capture the source before any cleanup happens
+			OBSSource source = OBSSource(item->GetSource());
+			// Defer the hide operation to ensure all signal handlers complete first
+			QMetaObject::invokeMethod(this, [this, source]() {
+				HideSource(source);
+			}, Qt::QueuedConnection);
+		});
+	}
+	if (virtualized && stripPlaceholderSize.isValid())
+		item->SetPlaceholderSize(stripPlaceholderSize);
+
+	// Add to list and order manager
+	mixerItems.push_back(item);
+	itemsBySource.emplace(source.Get(), item);
+	orderManager->AddSource(item->GetSourceUUID());
+
+	return item;
+}
+
 void AudioMixerDock::DeactivateAudioSource(OBSSource source)
 {
 	MixerItem *item = FindMixerItem(source);
 	if (!item)
 		return;
 
+	RemoveMixerItem(item);
+
+	// Update empty state and buttons
+	emptyLabel->setVisible(mixerItems.empty());
+	UpdateToolbarButtons();
+}
+
+void AudioMixerDock::RemoveMixerItem(MixerItem *item)
+{
 	// Clear selection if this item was selected
 	if (selectedItem == item) {
 		selectedItem = nullptr;
 	}
+	selectedItems.erase(item);
 
 	// Remove from list
 	auto it = std::find(mixerItems.begin(), mixerItems.end(), item);
 	if (it != mixerItems.end()) {
 		mixerItems.erase(it);
 	}
+	itemsBySource.erase(item->GetSource());
+	meterWall->RemoveSource(item->GetSource());
+
+	// Remove from layout, then keep it for reuse if the pool has room
+	mixerLayout->removeWidget(item);
+	if (RecycleMixerItem(item))
+		return;
 
-	// Remove from layout and cleanup
-	// Call Cleanup() immediately to detach from OBS objects while they're still valid
+	// Otherwise call Cleanup() immediately to detach from OBS objects while they're still valid
 	// Then use deleteLater() because this may be called from a signal handler
 	// while the item's context menu is still on the stack
-	mixerLayout->removeWidget(item);
 	item->Cleanup();
 	item->hide();
 	item->deleteLater();
-
-	// Update empty state and buttons
-	emptyLabel->setVisible(mixerItems.empty());
-	UpdateToolbarButtons();
 }
 
 void AudioMixerDock::OnSourceRenamed(QString newName, QString prevName)
@@ -468,6 +1237,15 @@ void AudioMixerDock::OnSourceRenamed(QString newName, QString prevName)
 	for (MixerItem *item : mixerItems) {
 		item->RefreshName();
 	}
+	meterWall->RefreshNames();
+}
+
+void AudioMixerDock::OnSceneCollectionChanging()
+{
+	// The cached hidden set belongs to the outgoing collection
+	std::lock_guard<std::mutex> lock(hiddenSourcesMutex);
+	hiddenSources.clear();
+	hiddenSourcesLoaded = false;
 }
 
 void AudioMixerDock::OnSceneCollectionChanged()
@@ -496,7 +1274,9 @@ void AudioMixerDock::OnSceneCollectionChanged()
 	}
 
 	// Re-enumerate sources
+	LoadHiddenSources();
 	EnumerateAudioSources();
+	StartOrderCleanup();
 }
 
 void AudioMixerDock::OnSceneChanged()
@@ -533,7 +1313,9 @@ void AudioMixerDock::OnFinishedLoading()
 		obs_source_release(scene);
 	}
 
+	LoadHiddenSources();
 	EnumerateAudioSources();
+	StartOrderCleanup();
 }
 
 void AudioMixerDock::SaveOrder()
@@ -543,60 +1325,202 @@ void AudioMixerDock::SaveOrder()
 
 void AudioMixerDock::OnExit()
 {
-	// Save order first
-	orderManager->Save();
+	// Write any pending order synchronously and stop the background saver
+	orderManager->Flush();
 
 	// Mark as shutting down - this prevents MixerItem from trying to
 	// detach/destroy faders which crashes when sources are already gone
 	shuttingDown = true;
 
-	// Disconnect signal handlers to prevent callbacks during cleanup
+	meterTimer->stop();
+
+	// Disconnect signal handlers to prevent callbacks during cleanup, and drop
+	// the source references held by events that were never flushed
 	DisconnectSignalHandlers();
+	sourceEventTimer->stop();
+	DiscardSourceEvents();
 
 	// Clear all mixer items - with shuttingDown=true, they won't touch OBS objects
 	ClearMixerItems();
 }
 
+bool AudioMixerDock::IsSourceHidden(obs_source_t *source)
+{
+	const char *uuid = obs_source_get_uuid(source);
+	{
+		std::lock_guard<std::mutex> lock(hiddenSourcesMutex);
+		if (hiddenSourcesLoaded)
+			return uuid && hiddenSources.count(uuid);
+	}
+
+	// Collection still loading
+	return SourceMixerHidden(source);
+}
+
+void AudioMixerDock::SetSourceHidden(obs_source_t *source, bool hidden)
+{
+	SetSourceMixerHidden(source, hidden);
+
+	const char *uuid = obs_source_get_uuid(source);
+	if (!uuid)
+		return;
+
+	std::lock_guard<std::mutex> lock(hiddenSourcesMutex);
+	if (hidden)
+		hiddenSources.insert(uuid);
+	else
+		hiddenSources.erase(uuid);
+}
+
+void AudioMixerDock::LoadHiddenSources()
+{
+	std::unordered_set<std::string> hidden;
+
+	auto loadCallback = [](void *data, obs_source_t *source) -> bool {
+		auto *set = static_cast<std::unordered_set<std::string> *>(data);
+
+		uint32_t flags = obs_source_get_output_flags(source);
+		if (!(flags & OBS_SOURCE_AUDIO) || !SourceMixerHidden(source))
+			return true;
+
+		const char *uuid = obs_source_get_uuid(source);
+		if (uuid)
+			set->insert(uuid);
+		return true;
+	};
+
+	obs_enum_sources(loadCallback, &hidden);
+
+	std::lock_guard<std::mutex> lock(hiddenSourcesMutex);
+	hiddenSources.swap(hidden);
+	hiddenSourcesLoaded = true;
+}
+
+void AudioMixerDock::StartOrderCleanup()
+{
+	// Gathered here, where OBS and the frontend may be queried; compared off the UI thread
+	OrderManager::LiveState live;
+
+	auto enumCallback = [](void *data, obs_source_t *source) -> bool {
+		const char *uuid = obs_source_get_uuid(source);
+		if (uuid)
+			static_cast<std::vector<std::string> *>(data)->emplace_back(uuid);
+		return true;
+	};
+	obs_enum_sources(enumCallback, &live.sources);
+
+	struct obs_frontend_source_list scenes = {};
+	obs_frontend_get_scenes(&scenes);
+	for (size_t i = 0; i < scenes.sources.num; i++) {
+		const char *name = obs_source_get_name(scenes.sources.array[i]);
+		if (name)
+			live.scenes.emplace_back(name);
+	}
+	obs_frontend_source_list_free(&scenes);
+
+	char **collections = obs_frontend_get_scene_collections();
+	for (char **name = collections; name && *name; name++) {
+		live.collections.emplace_back(*name);
+	}
+	bfree(collections);
+
+	orderManager->StartReconcile(std::move(live), [this]() {
+		QMetaObject::invokeMethod(this, [this]() {
+			if (!shuttingDown && orderManager->FinishReconcile())
+				orderManager->Save();
+		}, Qt::QueuedConnection);
+	});
+}
+
 void AudioMixerDock::HideSource(OBSSource source)
 {
-	if (!SourceMixerHidden(source)) {
-		SetSourceMixerHidden(source, true);
+	HideSources({source});
+}
+
+void AudioMixerDock::HideSources(const std::vector<OBSSource> &sources)
+{
+	bool changed = false;
+	for (const OBSSource &source : sources) {
+		if (IsSourceHidden(source))
+			continue;
+
+		SetSourceHidden(source, true);
 		// Remove from saved order - hidden sources lose their position
 		const char *uuid = obs_source_get_uuid(source);
 		if (uuid) {
 			orderManager->RemoveSource(uuid);
-			orderManager->Save();
 		}
-		DeactivateAudioSource(source);
+		if (MixerItem *item = FindMixerItem(source))
+			RemoveMixerItem(item);
+		changed = true;
 	}
+
+	if (!changed)
+		return;
+
+	// One save and one UI update for the whole batch
+	orderManager->Save();
+	emptyLabel->setVisible(mixerItems.empty());
+	UpdateToolbarButtons();
 }
 
 void AudioMixerDock::UnhideAllSources()
 {
+	std::vector<OBSSource> sources;
+
 	auto unhideCallback = [](void *data, obs_source_t *source) -> bool {
-		auto *dock = static_cast<AudioMixerDock *>(data);
+		auto *list = static_cast<std::vector<OBSSource> *>(data);
 
 		// Only process audio sources
 		uint32_t flags = obs_source_get_output_flags(source);
-		if (!(flags & OBS_SOURCE_AUDIO))
-			return true;
+		if (flags & OBS_SOURCE_AUDIO)
+			list->emplace_back(source);
+
+		return true;
+	};
+
+	obs_enum_sources(unhideCallback, &sources);
 
+	std::vector<OBSSource> activated;
+	for (const OBSSource &source : sources) {
 		// Only unhide if currently hidden
-		if (!SourceMixerHidden(source))
-			return true;
+		if (!IsSourceHidden(source))
+			continue;
 
-		// Unhide
-		SetSourceMixerHidden(source, false);
+		SetSourceHidden(source, false);
 
 		// Re-activate if source is active
-		if (obs_source_active(source)) {
-			dock->ActivateAudioSource(OBSSource(source));
-		}
+		if (obs_source_active(source))
+			activated.push_back(source);
+	}
 
-		return true;
-	};
+	PopulateAudioSources(activated);
+}
 
-	obs_enum_sources(unhideCallback, this);
+void AudioMixerDock::ImportOrder()
+{
+	QString path = QFileDialog::getOpenFileName(this, obs_module_text("BetterAudioMixer.ImportOrder"), QString(),
+						    "JSON (*.json)");
+	if (path.isEmpty())
+		return;
+
+	if (!orderManager->ImportJson(path.toStdString())) {
+		blog(LOG_WARNING, "[Reorderable Audio Mixer] Could not import order from %s", path.toUtf8().constData());
+		return;
+	}
+
+	orderManager->Save();
+	RefreshMixerLayout();
+}
+
+void AudioMixerDock::ExportOrder()
+{
+	QString path = QFileDialog::getSaveFileName(this, obs_module_text("BetterAudioMixer.ExportOrder"), QString(),
+						    "JSON (*.json)");
+	if (path.isEmpty())
+		return;
+
+	orderManager->ExportJson(path.toStdString());
 }
 
 void AudioMixerDock::ShowContextMenu(const QPoint &pos)
@@ -605,6 +1529,20 @@ void AudioMixerDock::ShowContextMenu(const QPoint &pos)
 
 	QMenu menu(this);
 
+	// Bulk actions for the current selection
+	if (!selectedItems.empty()) {
+		QAction *muteAction = menu.addAction(obs_module_text("BetterAudioMixer.MuteSelected"));
+		connect(muteAction, &QAction::triggered, this, [this]() { SetSelectionMuted(true); });
+
+		QAction *unmuteAction = menu.addAction(obs_module_text("BetterAudioMixer.UnmuteSelected"));
+		connect(unmuteAction, &QAction::triggered, this, [this]() { SetSelectionMuted(false); });
+
+		QAction *hideAction = menu.addAction(obs_module_text("BetterAudioMixer.HideSelected"));
+		connect(hideAction, &QAction::triggered, this, &AudioMixerDock::HideSelection);
+
+		menu.addSeparator();
+	}
+
 	// Toggle layout - show opposite of current state
 	const char *layoutText = vertical
 		? obs_module_text("BetterAudioMixer.HorizontalLayout")
@@ -614,11 +1552,47 @@ void AudioMixerDock::ShowContextMenu(const QPoint &pos)
 		SetVerticalLayout(!vertical);
 	});
 
+	QAction *virtualizedAction = menu.addAction(obs_module_text("BetterAudioMixer.VirtualizedList"));
+	virtualizedAction->setCheckable(true);
+	virtualizedAction->setChecked(virtualized);
+	connect(virtualizedAction, &QAction::triggered, this, [this](bool checked) {
+		SetVirtualizedList(checked);
+	});
+
+	QAction *meterWallAction = menu.addAction(obs_module_text("BetterAudioMixer.MeterWall"));
+	meterWallAction->setCheckable(true);
+	meterWallAction->setChecked(meterWallMode);
+	connect(meterWallAction, &QAction::triggered, this, [this](bool checked) {
+		SetMeterWall(checked);
+	});
+
 	menu.addSeparator();
 
 	QAction *unhideAllAction = menu.addAction(obs_module_text("BetterAudioMixer.UnhideAll"));
 	connect(unhideAllAction, &QAction::triggered, this, &AudioMixerDock::UnhideAllSources);
 
+	// How long orders remember sources, scenes and collections that no longer exist
+	QMenu *retentionMenu = menu.addMenu(obs_module_text("BetterAudioMixer.Retention"));
+	for (uint32_t days : {7u, 30u, 90u, 0u}) {
+		QString text = days ? QString(obs_module_text("BetterAudioMixer.RetentionDays")).arg(days)
+				    : QString(obs_module_text("BetterAudioMixer.RetentionNever"));
+		QAction *retentionAction = retentionMenu->addAction(text);
+		retentionAction->setCheckable(true);
+		retentionAction->setChecked(orderManager->GetRetentionDays() == days);
+		connect(retentionAction, &QAction::triggered, this, [this, days]() {
+			orderManager->SetRetentionDays(days);
+			orderManager->Save();
+		});
+	}
+
+	menu.addSeparator();
+
+	QAction *importAction = menu.addAction(obs_module_text("BetterAudioMixer.ImportOrder"));
+	connect(importAction, &QAction::triggered, this, &AudioMixerDock::ImportOrder);
+
+	QAction *exportAction = menu.addAction(obs_module_text("BetterAudioMixer.ExportOrder"));
+	connect(exportAction, &QAction::triggered, this, &AudioMixerDock::ExportOrder);
+
 	menu.exec(QCursor::pos());
 }
 
@@ -638,6 +1612,9 @@ void AudioMixerDock::SetVerticalLayout(bool vert)
 		scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
 	}
 
+	// Switch every strip in one repaint-free window; each strip only re-flows its own widgets
+	scrollWidget->setUpdatesEnabled(false);
+
 	// Replace mixer layout direction
 	QBoxLayout::Direction newDir = vertical ? QBoxLayout::LeftToRight : QBoxLayout::TopToBottom;
 	mixerLayout->setDirection(newDir);
@@ -650,6 +1627,12 @@ void AudioMixerDock::SetVerticalLayout(bool vert)
 		item->SetVertical(vertical);
 	}
 
+	// Placeholder footprint differs per orientation
+	stripPlaceholderSize = QSize();
+	UpdateStripPlaceholders();
+
+	scrollWidget->setUpdatesEnabled(true);
+
 	// Save preference
 	orderManager->SetVerticalLayout(vertical);
 	orderManager->Save();
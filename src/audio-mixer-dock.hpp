@@ -10,11 +10,18 @@
 #include <QMenu>
 #include <QToolBar>
 #include <QAction>
+#include <QTimer>
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class MixerItem;
 class OrderManager;
+class MeterBallistics;
+class MeterWall;
 
 // Helper functions for mixer hidden state (uses OBS's standard private settings)
 static inline bool SourceMixerHidden(obs_source_t *source)
@@ -38,8 +45,16 @@ public:
 
 	bool IsVertical() const { return vertical; }
 	void SetVerticalLayout(bool vert);
+	void SetVirtualizedList(bool enabled);
+	void SetMeterWall(bool enabled);
+
+protected:
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
+	bool eventFilter(QObject *obj, QEvent *event) override;
 
 public slots:
+	void OnSceneCollectionChanging();
 	void OnSceneCollectionChanged();
 	void OnSceneChanged();
 	void OnFinishedLoading();
@@ -51,33 +66,77 @@ public slots:
 	void OnSourceRenamed(QString newName, QString prevName);
 
 	void HideSource(OBSSource source);
+	void HideSources(const std::vector<OBSSource> &sources);
 	void UnhideAllSources();
+	void ImportOrder();
+	void ExportOrder();
 
 private slots:
 	void ShowContextMenu(const QPoint &pos);
-	void OnItemSelected(MixerItem *item);
+	void OnItemSelected(MixerItem *item, Qt::KeyboardModifiers modifiers);
+	void OnItemClicked(MixerItem *item, Qt::KeyboardModifiers modifiers);
 	void OnMoveUpClicked();
 	void OnMoveDownClicked();
+	void OnLaneContextMenu(int lane);
+	void RefreshMeters();
 
 private:
 	void SetupUI();
 	void ConnectSignalHandlers();
 	void DisconnectSignalHandlers();
+	void QueueSourceEvent(obs_source_t *source);
+	void FlushSourceEvents();
+	void DiscardSourceEvents();
 	void EnumerateAudioSources();
+	void PopulateAudioSources(const std::vector<OBSSource> &sources);
+	MixerItem *CreateMixerItem(OBSSource source);
+	bool RecycleMixerItem(MixerItem *item);
+	void ClearItemPool();
 	void ClearMixerItems();
 	void RefreshMixerLayout();
+	void ApplyLayoutOrder();
 	void UpdateToolbarButtons();
+	void ScheduleMeterVisibilityUpdate();
+	void UpdateMeterVisibility();
+	void UpdateStripPlaceholders();
+	void SyncMeterWall();
+	bool StripContentDeferred() const { return virtualized || meterWallMode; }
 	void SelectItem(MixerItem *item);
+	void SetItemSelected(MixerItem *item, bool selected);
+	void ClearSelection();
+	std::vector<MixerItem *> GetSelectedItems() const;
+
+	// Bulk operations on the selection, each applied as one transaction
+	void SetSelectionMuted(bool muted);
+	void HideSelection();
+	void MoveSelection(int direction);
+	void ApplyItemOrder(const std::vector<MixerItem *> &order);
+	void RemoveMixerItem(MixerItem *item);
+
+	// Mixer-hidden state, cached from the sources' private settings
+	bool IsSourceHidden(obs_source_t *source);
+	void SetSourceHidden(obs_source_t *source, bool hidden);
+	void LoadHiddenSources();
+	void StartOrderCleanup();
 
 	MixerItem *FindMixerItem(obs_source_t *source);
 	int GetItemIndex(MixerItem *item);
 
+	// Drag-and-drop reordering
+	bool HandleDragEvent(QEvent *event);
+	int DropIndexAt(const QPoint &pos) const;
+	void ShowDropIndicator(int index);
+	void AutoScrollForDrag(const QPoint &pos);
+	void MoveItem(int from, int gap);
+	void MoveItems(const std::vector<MixerItem *> &block, int gap);
+
 private:
 	QVBoxLayout *mainLayout = nullptr;
 	QScrollArea *scrollArea = nullptr;
 	QWidget *scrollWidget = nullptr;
 	QBoxLayout *mixerLayout = nullptr;
 	QLabel *emptyLabel = nullptr;
+	QFrame *dropIndicator = nullptr;
 
 	// Toolbar
 	QToolBar *toolbar = nullptr;
@@ -85,10 +144,51 @@ private:
 	QAction *downAction = nullptr;
 
 	std::vector<MixerItem *> mixerItems;
+	std::unordered_map<obs_source_t *, MixerItem *> itemsBySource;
+
+	// Detached strips kept for rebinding instead of being rebuilt
+	std::vector<MixerItem *> itemPool;
 	std::vector<OBSSignal> signalHandlers;
 
+	// (De)activation signals arrive on OBS threads; the sources they name are kept
+	// here and reconciled with their current state on the UI thread once per frame
+	std::mutex pendingSourceMutex;
+	std::unordered_map<obs_source_t *, OBSSource> pendingSourceEvents;
+	bool sourceFlushQueued = false;
+	QTimer *sourceEventTimer = nullptr;
+
+	// Shared meter clock: one tick per frame drives every VolumeMeter
+	QTimer *meterTimer = nullptr;
+	uint64_t lastMeterRefreshTime = 0;
+
+	// Metering is suspended for strips outside the viewport and while the dock is hidden
+	bool dockShown = false;
+	bool meterVisibilityUpdatePending = false;
+
+	// Ballistics for all meters, advanced in one batch per tick. Shared so that
+	// items still pending deleteLater() can release their slots safely.
+	std::shared_ptr<MeterBallistics> meterBallistics;
+
 	OrderManager *orderManager = nullptr;
+	// UUIDs of sources hidden in the mixer, loaded once per collection. Private
+	// settings stay the persistent source of truth and are read directly while
+	// the set isn't loaded. Queried from the signal thread, hence the mutex.
+	std::mutex hiddenSourcesMutex;
+	std::unordered_set<std::string> hiddenSources;
+	bool hiddenSourcesLoaded = false;
+
+	// Selection; selectedItem is the current item and the anchor for Shift ranges
 	MixerItem *selectedItem = nullptr;
+	std::unordered_set<MixerItem *> selectedItems;
 	bool vertical = false;
 	bool shuttingDown = false;
+
+	// Virtualized list: strips far from the viewport are empty placeholders
+	bool virtualized = false;
+	QSize stripPlaceholderSize;
+
+	// Meter wall: every source as one lane of a single painted widget, in list order.
+	// The strips stay in mixerItems as empty shells that carry order and selection.
+	MeterWall *meterWall = nullptr;
+	bool meterWallMode = false;
 };
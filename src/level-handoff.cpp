@@ -0,0 +1,63 @@
+#include "level-handoff.hpp"
+
+#include <util/platform.h>
+
+#include <cmath>
+
+static void clearSnapshot(LevelSnapshot &snapshot)
+{
+	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+		snapshot.magnitude[i] = -INFINITY;
+		snapshot.peak[i] = -INFINITY;
+		snapshot.inputPeak[i] = -INFINITY;
+	}
+}
+
+LevelHandoff::LevelHandoff()
+{
+	for (LevelSnapshot &snapshot : buffers)
+		clearSnapshot(snapshot);
+}
+
+void LevelHandoff::publish(uint64_t ts, const float magnitude[MAX_AUDIO_CHANNELS],
+			   const float peak[MAX_AUDIO_CHANNELS], const float inputPeak[MAX_AUDIO_CHANNELS])
+{
+	LevelSnapshot &snapshot = buffers[back];
+	snapshot.timestamp = ts;
+	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+		snapshot.magnitude[i] = magnitude[i];
+		snapshot.peak[i] = peak[i];
+		snapshot.inputPeak[i] = inputPeak[i];
+	}
+
+	// Release the filled buffer and take back whatever the consumer left behind
+	uint8_t previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+	back = previous & INDEX_MASK;
+}
+
+const LevelSnapshot &LevelHandoff::acquire()
+{
+	if (middle.load(std::memory_order_relaxed) & FRESH) {
+		uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+		front = previous & INDEX_MASK;
+
+		// A callback still in flight when metering was suspended may publish afterwards
+		if (buffers[front].timestamp < resetTime)
+			clearSnapshot(buffers[front]);
+	}
+	return buffers[front];
+}
+
+void LevelHandoff::reset()
+{
+	// Consume a snapshot still waiting in the middle slot first, or the next
+	// acquire() would show those old levels for a frame after resuming
+	if (middle.load(std::memory_order_relaxed) & FRESH) {
+		uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+		front = previous & INDEX_MASK;
+	}
+
+	// The last timestamp is kept so that idle detection still sees how old the data is
+	clearSnapshot(buffers[front]);
+	resetTime = os_gettime_ns();
+}
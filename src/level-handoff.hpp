@@ -0,0 +1,43 @@
+#pragma once
+
+#include <obs.h>
+
+#include <atomic>
+#include <cstdint>
+
+// One set of levels as delivered by an obs_volmeter callback
+struct LevelSnapshot {
+	uint64_t timestamp = 0;
+	float magnitude[MAX_AUDIO_CHANNELS];
+	float peak[MAX_AUDIO_CHANNELS];
+	float inputPeak[MAX_AUDIO_CHANNELS];
+};
+
+// Wait-free single-producer/single-consumer triple buffer for meter levels.
+// The audio thread fills its back buffer and swaps it into the shared middle
+// slot; the UI thread swaps the middle slot into its front buffer only when it
+// holds newer data. Neither side ever blocks, and the consumer always sees a
+// complete snapshot from a single callback.
+class LevelHandoff {
+public:
+	LevelHandoff();
+
+	// Producer side (audio thread)
+	void publish(uint64_t ts, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
+		     const float inputPeak[MAX_AUDIO_CHANNELS]);
+
+	// Consumer side (UI thread)
+	const LevelSnapshot &acquire();
+	// Drops any pending snapshot and clears the levels, e.g. when metering resumes
+	void reset();
+
+private:
+	static constexpr uint8_t INDEX_MASK = 0x3;
+	static constexpr uint8_t FRESH = 0x4;
+
+	LevelSnapshot buffers[3];
+	std::atomic<uint8_t> middle{1};
+	uint8_t back = 0;  // Owned by the producer
+	uint8_t front = 2; // Owned by the consumer
+	uint64_t resetTime = 0; // Owned by the consumer; older snapshots are dropped
+};
@@ -0,0 +1,225 @@
+#include "meter-ballistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(BALLISTICS_FORCE_SCALAR)
+// Used by the tests to check the scalar kernel on targets that would pick a vector one
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define BALLISTICS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BALLISTICS_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define BALLISTICS_NEON
+#endif
+
+// Lanes are allocated in multiples of this so every vector width divides the lane count
+#define LANE_ALIGNMENT 8
+
+namespace {
+
+#if defined(BALLISTICS_AVX)
+struct Simd {
+	using V = __m256;
+	using M = __m256;
+	static constexpr size_t WIDTH = 8;
+
+	static V load(const float *p) { return _mm256_loadu_ps(p); }
+	static void store(float *p, V v) { _mm256_storeu_ps(p, v); }
+	static V set1(float f) { return _mm256_set1_ps(f); }
+	static V add(V a, V b) { return _mm256_add_ps(a, b); }
+	static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+	static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+	static V min(V a, V b) { return _mm256_min_ps(a, b); }
+	static V max(V a, V b) { return _mm256_max_ps(a, b); }
+	static M ge(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	static M gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static M isNan(V a) { return _mm256_cmp_ps(a, a, _CMP_UNORD_Q); }
+	static M notFinite(V a) { return _mm256_cmp_ps(_mm256_sub_ps(a, a), _mm256_setzero_ps(), _CMP_NEQ_UQ); }
+	static M either(M a, M b) { return _mm256_or_ps(a, b); }
+	static V select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+};
+#elif defined(BALLISTICS_SSE2)
+struct Simd {
+	using V = __m128;
+	using M = __m128;
+	static constexpr size_t WIDTH = 4;
+
+	static V load(const float *p) { return _mm_loadu_ps(p); }
+	static void store(float *p, V v) { _mm_storeu_ps(p, v); }
+	static V set1(float f) { return _mm_set1_ps(f); }
+	static V add(V a, V b) { return _mm_add_ps(a, b); }
+	static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+	static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+	static V min(V a, V b) { return _mm_min_ps(a, b); }
+	static V max(V a, V b) { return _mm_max_ps(a, b); }
+	static M ge(V a, V b) { return _mm_cmpge_ps(a, b); }
+	static M gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+	static M isNan(V a) { return _mm_cmpunord_ps(a, a); }
+	static M notFinite(V a) { return _mm_cmpneq_ps(_mm_sub_ps(a, a), _mm_setzero_ps()); }
+	static M either(M a, M b) { return _mm_or_ps(a, b); }
+	static V select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+#elif defined(BALLISTICS_NEON)
+struct Simd {
+	using V = float32x4_t;
+	using M = uint32x4_t;
+	static constexpr size_t WIDTH = 4;
+
+	static V load(const float *p) { return vld1q_f32(p); }
+	static void store(float *p, V v) { vst1q_f32(p, v); }
+	static V set1(float f) { return vdupq_n_f32(f); }
+	static V add(V a, V b) { return vaddq_f32(a, b); }
+	static V sub(V a, V b) { return vsubq_f32(a, b); }
+	static V mul(V a, V b) { return vmulq_f32(a, b); }
+	static V min(V a, V b) { return vminq_f32(a, b); }
+	static V max(V a, V b) { return vmaxq_f32(a, b); }
+	static M ge(V a, V b) { return vcgeq_f32(a, b); }
+	static M gt(V a, V b) { return vcgtq_f32(a, b); }
+	static M isNan(V a) { return vmvnq_u32(vceqq_f32(a, a)); }
+	static M notFinite(V a) { return vmvnq_u32(vceqq_f32(vsubq_f32(a, a), vdupq_n_f32(0.0f))); }
+	static M either(M a, M b) { return vorrq_u32(a, b); }
+	static V select(M m, V a, V b) { return vbslq_f32(m, a, b); }
+};
+#else
+struct Simd {
+	using V = float;
+	using M = bool;
+	static constexpr size_t WIDTH = 1;
+
+	static V load(const float *p) { return *p; }
+	static void store(float *p, V v) { *p = v; }
+	static V set1(float f) { return f; }
+	static V add(V a, V b) { return a + b; }
+	static V sub(V a, V b) { return a - b; }
+	static V mul(V a, V b) { return a * b; }
+	static V min(V a, V b) { return std::min(a, b); }
+	static V max(V a, V b) { return std::max(a, b); }
+	static M ge(V a, V b) { return a >= b; }
+	static M gt(V a, V b) { return a > b; }
+	static M isNan(V a) { return std::isnan(a); }
+	static M notFinite(V a) { return !std::isfinite(a); }
+	static M either(M a, M b) { return a || b; }
+	static V select(M m, V a, V b) { return m ? a : b; }
+};
+#endif
+
+} // namespace
+
+MeterBallistics::MeterBallistics(int channelsPerSlot) : slotChannels(std::max(channelsPerSlot, 1)) {}
+
+int MeterBallistics::allocateSlot()
+{
+	if (!freeSlots.empty()) {
+		int slot = freeSlots.back();
+		freeSlots.pop_back();
+		resetSlot(slot);
+		return slot;
+	}
+
+	int slot = slotCount++;
+	size_t needed = size_t(slotCount) * size_t(slotChannels);
+	if (needed > laneCount) {
+		size_t first = laneCount;
+		laneCount = (needed + LANE_ALIGNMENT - 1) / LANE_ALIGNMENT * LANE_ALIGNMENT;
+
+		currentMagnitude.resize(laneCount);
+		currentPeak.resize(laneCount);
+		currentInputPeak.resize(laneCount);
+		displayMagnitude.resize(laneCount);
+		displayPeak.resize(laneCount);
+		displayPeakHold.resize(laneCount);
+		displayPeakHoldAge.resize(laneCount);
+		displayInputPeakHold.resize(laneCount);
+		displayInputPeakHoldAge.resize(laneCount);
+
+		resetLanes(first, laneCount - first);
+	} else {
+		resetSlot(slot);
+	}
+	return slot;
+}
+
+void MeterBallistics::releaseSlot(int slot)
+{
+	if (slot < 0 || slot >= slotCount)
+		return;
+
+	// Released lanes sit at -inf, where every rule below is a fixed point
+	resetSlot(slot);
+	freeSlots.push_back(slot);
+}
+
+void MeterBallistics::resetSlot(int slot)
+{
+	resetLanes(size_t(slot) * size_t(slotChannels), size_t(slotChannels));
+}
+
+void MeterBallistics::resetLanes(size_t first, size_t count)
+{
+	for (size_t lane = first; lane < first + count; lane++) {
+		currentMagnitude[lane] = -INFINITY;
+		currentPeak[lane] = -INFINITY;
+		currentInputPeak[lane] = -INFINITY;
+		displayMagnitude[lane] = -INFINITY;
+		displayPeak[lane] = -INFINITY;
+		displayPeakHold[lane] = -INFINITY;
+		displayPeakHoldAge[lane] = 0.0f;
+		displayInputPeakHold[lane] = -INFINITY;
+		displayInputPeakHoldAge[lane] = 0.0f;
+	}
+}
+
+void MeterBallistics::process(float dt)
+{
+	// A zero step would turn the VU integration of a silent channel into NaN
+	if (!(dt > 0.0f) || laneCount == 0)
+		return;
+
+	using S = Simd;
+
+	const S::V zero = S::set1(0.0f);
+	const S::V step = S::set1(dt);
+	const S::V decay = S::set1(peakDecayRate * dt);
+	const S::V integration = S::set1(dt / magnitudeIntegrationTime * 0.99f);
+	const S::V holdDuration = S::set1(peakHoldDuration);
+	const S::V inputHoldDuration = S::set1(inputPeakHoldDuration);
+	const S::V minimum = S::set1(minimumLevel);
+
+	for (size_t i = 0; i < laneCount; i += S::WIDTH) {
+		S::V peakIn = S::load(&currentPeak[i]);
+		S::V inputPeakIn = S::load(&currentInputPeak[i]);
+		S::V magnitudeIn = S::load(&currentMagnitude[i]);
+
+		// Attack of peak is immediate, otherwise decay towards min(current, 0)
+		S::V peak = S::load(&displayPeak[i]);
+		S::M peakAttack = S::either(S::ge(peakIn, peak), S::isNan(peak));
+		S::V peakDecayed = S::max(S::min(S::sub(peak, decay), zero), S::min(peakIn, zero));
+		S::store(&displayPeak[i], S::select(peakAttack, peakIn, peakDecayed));
+
+		// Peak hold: immediate attack, falls back to the current peak after the hold duration
+		S::V hold = S::load(&displayPeakHold[i]);
+		S::V holdAge = S::add(S::load(&displayPeakHoldAge[i]), step);
+		S::M holdReset = S::either(S::either(S::ge(peakIn, hold), S::notFinite(hold)),
+					   S::gt(holdAge, holdDuration));
+		S::store(&displayPeakHold[i], S::select(holdReset, peakIn, hold));
+		S::store(&displayPeakHoldAge[i], S::select(holdReset, zero, holdAge));
+
+		// Input peak hold: same rule with the shorter input hold duration
+		S::V inputHold = S::load(&displayInputPeakHold[i]);
+		S::V inputHoldAge = S::add(S::load(&displayInputPeakHoldAge[i]), step);
+		S::M inputHoldReset = S::either(S::either(S::ge(inputPeakIn, inputHold), S::notFinite(inputHold)),
+						S::gt(inputHoldAge, inputHoldDuration));
+		S::store(&displayInputPeakHold[i], S::select(inputHoldReset, inputPeakIn, inputHold));
+		S::store(&displayInputPeakHoldAge[i], S::select(inputHoldReset, zero, inputHoldAge));
+
+		// VU meter integration, clamped to [minimumLevel, 0]
+		S::V magnitude = S::load(&displayMagnitude[i]);
+		S::V integrated = S::add(magnitude, S::mul(S::sub(magnitudeIn, magnitude), integration));
+		integrated = S::max(S::min(integrated, zero), minimum);
+		S::store(&displayMagnitude[i], S::select(S::notFinite(magnitude), magnitudeIn, integrated));
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Batched meter ballistics for every meter in the dock.
+//
+// State is kept in structure-of-arrays form, one lane per displayed channel,
+// so peak decay, peak hold, input-peak hold and VU integration for all meters
+// advance in one vectorised pass per frame (AVX, SSE2 or NEON when the target
+// supports it, scalar otherwise). Meters own a slot of channelsPerSlot()
+// consecutive lanes, write their latest levels into it before process() and
+// read the display values back afterwards.
+class MeterBallistics {
+public:
+	explicit MeterBallistics(int channelsPerSlot);
+
+	int channelsPerSlot() const { return slotChannels; }
+
+	// Slot management; a slot's first lane is slot * channelsPerSlot()
+	int allocateSlot();
+	void releaseSlot(int slot);
+	void resetSlot(int slot);
+
+	// Inputs for the next process() call
+	void setInput(size_t lane, float magnitude, float peak, float inputPeak)
+	{
+		currentMagnitude[lane] = magnitude;
+		currentPeak[lane] = peak;
+		currentInputPeak[lane] = inputPeak;
+	}
+
+	// Advance every lane by dt seconds
+	void process(float dt);
+
+	// Display values after process()
+	float magnitude(size_t lane) const { return displayMagnitude[lane]; }
+	float peak(size_t lane) const { return displayPeak[lane]; }
+	float peakHold(size_t lane) const { return displayPeakHold[lane]; }
+	float inputPeakHold(size_t lane) const { return displayInputPeakHold[lane]; }
+
+	// Meter settings, shared by all meters
+	float minimumLevel = -60.0f;
+	float peakDecayRate = 11.76f;          // 20 dB / 1.7 sec
+	float magnitudeIntegrationTime = 0.3f; // 99% in 300 ms
+	float peakHoldDuration = 20.0f;        // 20 seconds
+	float inputPeakHoldDuration = 1.0f;    // 1 second
+
+private:
+	void resetLanes(size_t first, size_t count);
+
+	int slotChannels;
+	std::vector<int> freeSlots;
+	int slotCount = 0;
+
+	// Lane count is kept a multiple of the widest vector so the kernel needs no tail loop
+	size_t laneCount = 0;
+
+	std::vector<float> currentMagnitude;
+	std::vector<float> currentPeak;
+	std::vector<float> currentInputPeak;
+
+	std::vector<float> displayMagnitude;
+	std::vector<float> displayPeak;
+	std::vector<float> displayPeakHold;
+	std::vector<float> displayPeakHoldAge;
+	std::vector<float> displayInputPeakHold;
+	std::vector<float> displayInputPeakHoldAge;
+};
@@ -0,0 +1,586 @@
+#include "meter-wall.hpp"
+#include "meter-ballistics.hpp"
+#include "volume-meter.hpp"
+
+#include <util/platform.h>
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QShowEvent>
+#include <QStyle>
+#include <QContextMenuEvent>
+#include <QScrollBar>
+#include <QEvent>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+// Levels older than this are treated as silence
+#define IDLE_TIMEOUT_NS 500000000ULL
+
+// Lane geometry: [mute box][name][meter], one lane per source
+#define LANE_PADDING 2
+#define LANE_MIN_HEIGHT 14
+#define MUTE_COLUMN_WIDTH 18
+#define MUTE_BOX_SIZE 10
+#define NAME_COLUMN_WIDTH 140
+#define COLUMN_SPACING 4
+#define CHANNEL_SPACING 1
+
+// Moves per-lane entries into the order given by from, dropping lanes not listed
+template<typename T> static void ApplyPermutation(std::vector<T> &values, const std::vector<size_t> &from, size_t stride = 1)
+{
+	std::vector<T> permuted;
+	permuted.reserve(from.size() * stride);
+	for (size_t index : from) {
+		for (size_t k = 0; k < stride; k++)
+			permuted.push_back(std::move(values[index * stride + k]));
+	}
+	values.swap(permuted);
+}
+
+MeterWall::MeterWall(std::shared_ptr<MeterBallistics> ballistics_, QWidget *parent)
+	: QAbstractScrollArea(parent),
+	  ballistics(std::move(ballistics_)),
+	  channels(std::min(ballistics->channelsPerSlot(), MAX_AUDIO_CHANNELS))
+{
+	setFrameShape(QFrame::NoFrame);
+	setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+	viewport()->setAttribute(Qt::WA_OpaquePaintEvent, true);
+
+	themeProbe = new VolumeMeter(ballistics, this);
+	themeProbe->hide();
+
+	UpdateLaneHeight();
+}
+
+MeterWall::~MeterWall()
+{
+	Clear();
+}
+
+void MeterWall::SetSources(const std::vector<OBSSource> &newSources)
+{
+	// Existing lanes are reused by source; new ones are appended, then everything is permuted once
+	std::vector<uint8_t> kept(sources.size(), 0);
+	std::vector<size_t> from;
+	from.reserve(newSources.size());
+
+	for (const OBSSource &source : newSources) {
+		auto it = laneBySource.find(source.Get());
+		if (it == laneBySource.end()) {
+			AddLane(source);
+			from.push_back(sources.size() - 1);
+		} else if (it->second >= kept.size() || !kept[it->second]) {
+			if (it->second < kept.size())
+				kept[it->second] = 1;
+			from.push_back(it->second);
+		}
+	}
+
+	for (size_t lane = 0; lane < kept.size(); lane++) {
+		if (!kept[lane])
+			ReleaseLane(lane, false);
+	}
+
+	PermuteLanes(from);
+}
+
+void MeterWall::RemoveSource(obs_source_t *source)
+{
+	auto it = laneBySource.find(source);
+	if (it == laneBySource.end())
+		return;
+
+	const size_t removed = it->second;
+	ReleaseLane(removed, false);
+
+	std::vector<size_t> from;
+	from.reserve(sources.size() - 1);
+	for (size_t lane = 0; lane < sources.size(); lane++) {
+		if (lane != removed)
+			from.push_back(lane);
+	}
+	PermuteLanes(from);
+}
+
+void MeterWall::Clear(bool isShutdown)
+{
+	for (size_t lane = 0; lane < sources.size(); lane++) {
+		ReleaseLane(lane, isShutdown);
+	}
+	pressedLane = -1;
+	PermuteLanes({});
+}
+
+void MeterWall::AddLane(const OBSSource &source)
+{
+	const char *name = obs_source_get_name(source);
+
+	laneBySource[source.Get()] = sources.size();
+	sources.push_back(source);
+	names.push_back(name ? QString::fromUtf8(name) : QString());
+	volmeters.emplace_back();
+	handoffs.push_back(std::make_unique<LevelHandoff>());
+	ballisticsSlots.push_back(ballistics->allocateSlot());
+	muted.push_back(obs_source_muted(source));
+	selected.push_back(0);
+	metering.push_back(0);
+	idle.push_back(1);
+
+	displayedMagnitude.insert(displayedMagnitude.end(), channels, -1);
+	displayedPeak.insert(displayedPeak.end(), channels, -1);
+	displayedPeakHold.insert(displayedPeakHold.end(), channels, -1);
+}
+
+void MeterWall::ReleaseLane(size_t lane, bool isShutdown)
+{
+	OBSVolMeter &volmeter = volmeters[lane];
+	if (volmeter) {
+		// Once the callback is removed the audio thread no longer touches the handoff
+		obs_volmeter_remove_callback(volmeter, OBSVolumeLevel, handoffs[lane].get());
+
+		// During shutdown sources are already gone; detaching would crash
+		if (!isShutdown && metering[lane])
+			obs_volmeter_detach_source(volmeter);
+		volmeter = nullptr;
+	}
+	metering[lane] = 0;
+
+	ballistics->releaseSlot(ballisticsSlots[lane]);
+	ballisticsSlots[lane] = -1;
+}
+
+void MeterWall::PermuteLanes(const std::vector<size_t> &from)
+{
+	ApplyPermutation(sources, from);
+	ApplyPermutation(names, from);
+	ApplyPermutation(volmeters, from);
+	ApplyPermutation(handoffs, from);
+	ApplyPermutation(ballisticsSlots, from);
+	ApplyPermutation(muted, from);
+	ApplyPermutation(selected, from);
+	ApplyPermutation(metering, from);
+	ApplyPermutation(idle, from);
+	ApplyPermutation(displayedMagnitude, from, channels);
+	ApplyPermutation(displayedPeak, from, channels);
+	ApplyPermutation(displayedPeakHold, from, channels);
+
+	laneBySource.clear();
+	for (size_t lane = 0; lane < sources.size(); lane++) {
+		laneBySource.emplace(sources[lane].Get(), lane);
+	}
+	pressedLane = -1;
+
+	UpdateScrollRange();
+	UpdateMeteredLanes();
+	viewport()->update();
+}
+
+void MeterWall::SetLaneSelected(obs_source_t *source, bool sel)
+{
+	auto it = laneBySource.find(source);
+	if (it == laneBySource.end() || selected[it->second] == sel)
+		return;
+
+	selected[it->second] = sel;
+	viewport()->update(LaneRect(static_cast<int>(it->second)));
+}
+
+void MeterWall::ClearSelection()
+{
+	for (size_t lane = 0; lane < selected.size(); lane++) {
+		if (!selected[lane])
+			continue;
+		selected[lane] = 0;
+		viewport()->update(LaneRect(static_cast<int>(lane)));
+	}
+}
+
+void MeterWall::RefreshNames()
+{
+	for (size_t lane = 0; lane < sources.size(); lane++) {
+		const char *name = obs_source_get_name(sources[lane]);
+		names[lane] = name ? QString::fromUtf8(name) : QString();
+	}
+	viewport()->update();
+}
+
+void MeterWall::SetMeteringActive(bool active)
+{
+	if (meteringActive == active)
+		return;
+
+	meteringActive = active;
+	UpdateMeteredLanes();
+}
+
+void MeterWall::SetLaneMetering(size_t lane, bool active)
+{
+	if (bool(metering[lane]) == active)
+		return;
+
+	metering[lane] = active;
+
+	if (active) {
+		// Volmeters are created the first time a lane comes on screen
+		if (!volmeters[lane]) {
+			volmeters[lane] = obs_volmeter_create(OBS_FADER_LOG);
+			obs_volmeter_add_callback(volmeters[lane], OBSVolumeLevel, handoffs[lane].get());
+		}
+		obs_volmeter_attach_source(volmeters[lane], sources[lane]);
+	} else {
+		// Detaching stops libobs from computing levels for this source at all
+		obs_volmeter_detach_source(volmeters[lane]);
+
+		// Resume from silence when the lane scrolls back in
+		handoffs[lane]->reset();
+		ballistics->resetSlot(ballisticsSlots[lane]);
+		idle[lane] = 1;
+		ResetDisplayedState(lane);
+	}
+}
+
+void MeterWall::UpdateMeteredLanes()
+{
+	int first = 0;
+	int last = -1;
+	if (meteringActive && !sources.empty() && laneHeight > 0) {
+		int offset = verticalScrollBar()->value();
+		first = offset / laneHeight;
+		last = std::min((offset + viewport()->height() - 1) / laneHeight, LaneCount() - 1);
+	}
+
+	for (size_t lane = 0; lane < sources.size(); lane++) {
+		int index = static_cast<int>(lane);
+		SetLaneMetering(lane, index >= first && index <= last);
+	}
+
+	firstMeteredLane = first;
+	lastMeteredLane = last;
+}
+
+void MeterWall::ResetDisplayedState(size_t lane)
+{
+	for (int channelNr = 0; channelNr < channels; channelNr++) {
+		size_t index = lane * channels + channelNr;
+		displayedMagnitude[index] = -1;
+		displayedPeak[index] = -1;
+		displayedPeakHold[index] = -1;
+	}
+}
+
+void MeterWall::UpdateScrollRange()
+{
+	QScrollBar *bar = verticalScrollBar();
+	int contentHeight = LaneCount() * laneHeight;
+	bar->setRange(0, std::max(contentHeight - viewport()->height(), 0));
+	bar->setPageStep(viewport()->height());
+	bar->setSingleStep(laneHeight);
+}
+
+void MeterWall::UpdateLaneHeight()
+{
+	laneHeight = std::max(fontMetrics().height() + LANE_PADDING * 2, LANE_MIN_HEIGHT);
+}
+
+void MeterWall::PullLevels(uint64_t ts)
+{
+	const size_t lanesPerSlot = size_t(ballistics->channelsPerSlot());
+
+	for (int i = firstMeteredLane; i <= lastMeteredLane; i++) {
+		size_t lane = size_t(i);
+		const LevelSnapshot &current = handoffs[lane]->acquire();
+
+		if (ts > current.timestamp && ts - current.timestamp > IDLE_TIMEOUT_NS) {
+			// Reset lanes stay at -inf in the engine, so there is nothing to feed
+			if (!idle[lane]) {
+				handoffs[lane]->reset();
+				ballistics->resetSlot(ballisticsSlots[lane]);
+				idle[lane] = 1;
+			}
+			continue;
+		}
+
+		idle[lane] = 0;
+		size_t first = size_t(ballisticsSlots[lane]) * lanesPerSlot;
+		for (int channelNr = 0; channelNr < channels; channelNr++) {
+			ballistics->setInput(first + channelNr, current.magnitude[channelNr], current.peak[channelNr],
+					     current.inputPeak[channelNr]);
+		}
+	}
+}
+
+void MeterWall::Refresh()
+{
+	const int length = MeterLength();
+	const size_t lanesPerSlot = size_t(ballistics->channelsPerSlot());
+
+	// Only lanes whose painted state changed are invalidated
+	for (int i = firstMeteredLane; i <= lastMeteredLane; i++) {
+		size_t lane = size_t(i);
+
+		// Polled rather than signalled: only on-screen lanes matter and this is one load each
+		bool isMuted = obs_source_muted(sources[lane]);
+		bool changed = isMuted != bool(muted[lane]);
+		muted[lane] = isMuted;
+
+		size_t first = size_t(ballisticsSlots[lane]) * lanesPerSlot;
+		for (int channelNr = 0; channelNr < channels; channelNr++) {
+			size_t index = lane * channels + channelNr;
+			int magnitudePosition = LevelToPosition(ballistics->magnitude(first + channelNr), length);
+			int peakPosition = LevelToPosition(ballistics->peak(first + channelNr), length);
+			int peakHoldPosition = LevelToPosition(ballistics->peakHold(first + channelNr), length);
+
+			if (magnitudePosition != displayedMagnitude[index] || peakPosition != displayedPeak[index] ||
+			    peakHoldPosition != displayedPeakHold[index]) {
+				displayedMagnitude[index] = magnitudePosition;
+				displayedPeak[index] = peakPosition;
+				displayedPeakHold[index] = peakHoldPosition;
+				changed = true;
+			}
+		}
+
+		if (changed)
+			viewport()->update(LaneRect(i));
+	}
+}
+
+int MeterWall::LaneAt(const QPoint &pos) const
+{
+	if (laneHeight <= 0 || pos.y() < 0)
+		return -1;
+
+	int lane = (pos.y() + verticalScrollBar()->value()) / laneHeight;
+	return lane < LaneCount() ? lane : -1;
+}
+
+QRect MeterWall::LaneRect(int lane) const
+{
+	return QRect(0, lane * laneHeight - verticalScrollBar()->value(), viewport()->width(), laneHeight);
+}
+
+int MeterWall::NameWidth() const
+{
+	return std::min(NAME_COLUMN_WIDTH, viewport()->width() / 3);
+}
+
+int MeterWall::MeterX() const
+{
+	return MUTE_COLUMN_WIDTH + NameWidth() + COLUMN_SPACING;
+}
+
+int MeterWall::MeterLength() const
+{
+	return viewport()->width() - MeterX() - COLUMN_SPACING;
+}
+
+int MeterWall::LevelToPosition(float level, int length) const
+{
+	// Everything below the scale draws identically, as does everything past 0 dB
+	if (!(level >= minimumLevel) || length <= 0)
+		return -1;
+
+	return std::clamp(length - int(level / minimumLevel * length), 0, length);
+}
+
+void MeterWall::paintEvent(QPaintEvent *event)
+{
+	QPainter painter(viewport());
+	const QRect dirty = event->rect();
+	painter.fillRect(dirty, palette().color(QPalette::Window));
+
+	if (sources.empty() || laneHeight <= 0)
+		return;
+
+	// Only the lanes intersecting the exposed area are painted
+	int offset = verticalScrollBar()->value();
+	int first = std::max((dirty.top() + offset) / laneHeight, 0);
+	int last = std::min((dirty.bottom() + offset) / laneHeight, LaneCount() - 1);
+	for (int lane = first; lane <= last; lane++) {
+		PaintLane(painter, size_t(lane), LaneRect(lane));
+	}
+}
+
+void MeterWall::PaintLane(QPainter &painter, size_t lane, const QRect &rect)
+{
+	const bool isMuted = muted[lane];
+	const bool isSelected = selected[lane];
+
+	if (isSelected)
+		painter.fillRect(rect, palette().color(QPalette::Highlight));
+
+	// Mute box: filled while muted
+	QRect box(rect.x() + (MUTE_COLUMN_WIDTH - MUTE_BOX_SIZE) / 2, rect.y() + (rect.height() - MUTE_BOX_SIZE) / 2,
+		  MUTE_BOX_SIZE, MUTE_BOX_SIZE);
+	const QColor textColor = palette().color(isSelected ? QPalette::HighlightedText : QPalette::WindowText);
+	painter.setPen(textColor);
+	painter.setBrush(isMuted ? QBrush(foregroundErrorColor) : QBrush(Qt::NoBrush));
+	painter.drawRect(box.adjusted(0, 0, -1, -1));
+
+	// Name
+	const int nameWidth = NameWidth();
+	QRect nameRect(rect.x() + MUTE_COLUMN_WIDTH, rect.y(), nameWidth, rect.height());
+	painter.drawText(nameRect, Qt::AlignLeft | Qt::AlignVCenter,
+			 fontMetrics().elidedText(names[lane], Qt::ElideRight, nameWidth));
+
+	// Meter: one thin bar per channel
+	const int length = MeterLength();
+	if (length <= 0)
+		return;
+
+	const int x = rect.x() + MeterX();
+	const int barsHeight = rect.height() - LANE_PADDING * 2;
+	const int barHeight = std::max((barsHeight - (channels - 1) * CHANNEL_SPACING) / std::max(channels, 1), 1);
+	const int warningPosition = LevelToPosition(warningLevel, length);
+	const int errorPosition = LevelToPosition(errorLevel, length);
+
+	auto paintZones = [&](int y, int limit, const QColor &nominal, const QColor &warning, const QColor &error) {
+		if (limit <= 0)
+			return;
+		painter.fillRect(x, y, std::min(limit, warningPosition), barHeight, nominal);
+		if (limit > warningPosition)
+			painter.fillRect(x + warningPosition, y, std::min(limit, errorPosition) - warningPosition,
+					 barHeight, warning);
+		if (limit > errorPosition)
+			painter.fillRect(x + errorPosition, y, limit - errorPosition, barHeight, error);
+	};
+
+	for (int channelNr = 0; channelNr < channels; channelNr++) {
+		const size_t index = lane * channels + channelNr;
+		const int y = rect.y() + LANE_PADDING + channelNr * (barHeight + CHANNEL_SPACING);
+
+		if (isMuted) {
+			painter.fillRect(x, y, length, barHeight, mutedBackgroundColor);
+			if (displayedPeak[index] > 0)
+				painter.fillRect(x, y, displayedPeak[index], barHeight, mutedForegroundColor);
+		} else {
+			paintZones(y, length, backgroundNominalColor, backgroundWarningColor, backgroundErrorColor);
+			paintZones(y, displayedPeak[index], foregroundNominalColor, foregroundWarningColor,
+				   foregroundErrorColor);
+		}
+
+		if (displayedMagnitude[index] > 0)
+			painter.fillRect(x + displayedMagnitude[index] - 1, y, 1, barHeight, magnitudeColor);
+		if (displayedPeakHold[index] > 0) {
+			// Colored by zone, like VolumeMeter's peak hold indicator
+			const int hold = displayedPeakHold[index];
+			const QColor &holdColor = isMuted                   ? mutedForegroundColor
+						  : hold <= warningPosition ? foregroundNominalColor
+						  : hold <= errorPosition   ? foregroundWarningColor
+									    : foregroundErrorColor;
+			painter.fillRect(x + hold - 1, y, 1, barHeight, holdColor);
+		}
+	}
+}
+
+void MeterWall::resizeEvent(QResizeEvent *event)
+{
+	QAbstractScrollArea::resizeEvent(event);
+	UpdateScrollRange();
+	UpdateMeteredLanes();
+}
+
+void MeterWall::scrollContentsBy(int dx, int dy)
+{
+	Q_UNUSED(dx);
+	Q_UNUSED(dy);
+
+	UpdateMeteredLanes();
+	viewport()->update();
+}
+
+void MeterWall::changeEvent(QEvent *event)
+{
+	switch (event->type()) {
+	case QEvent::FontChange:
+		UpdateLaneHeight();
+		UpdateScrollRange();
+		UpdateMeteredLanes();
+		viewport()->update();
+		break;
+	case QEvent::PaletteChange:
+	case QEvent::StyleChange:
+		// Children may not have their new style yet; read it once this event is done
+		QMetaObject::invokeMethod(this, [this]() { UpdateColors(); }, Qt::QueuedConnection);
+		break;
+	default:
+		break;
+	}
+	QAbstractScrollArea::changeEvent(event);
+}
+
+void MeterWall::showEvent(QShowEvent *event)
+{
+	QAbstractScrollArea::showEvent(event);
+	UpdateColors();
+}
+
+void MeterWall::UpdateColors()
+{
+	// A hidden widget isn't repolished on its own, so apply the current rules explicitly
+	themeProbe->style()->unpolish(themeProbe);
+	themeProbe->style()->polish(themeProbe);
+
+	backgroundNominalColor = themeProbe->getBackgroundNominalColor();
+	backgroundWarningColor = themeProbe->getBackgroundWarningColor();
+	backgroundErrorColor = themeProbe->getBackgroundErrorColor();
+	foregroundNominalColor = themeProbe->getForegroundNominalColor();
+	foregroundWarningColor = themeProbe->getForegroundWarningColor();
+	foregroundErrorColor = themeProbe->getForegroundErrorColor();
+	magnitudeColor = themeProbe->getMagnitudeColor();
+	viewport()->update();
+}
+
+void MeterWall::mousePressEvent(QMouseEvent *event)
+{
+	pressedLane = -1;
+
+	int lane = LaneAt(event->position().toPoint());
+	if (event->button() != Qt::LeftButton || lane < 0) {
+		QAbstractScrollArea::mousePressEvent(event);
+		return;
+	}
+
+	// The mute column toggles directly, like the strip's mute checkbox
+	if (event->position().x() < MUTE_COLUMN_WIDTH) {
+		obs_source_t *source = sources[lane];
+		bool isMuted = !obs_source_muted(source);
+		obs_source_set_muted(source, isMuted);
+		muted[lane] = isMuted;
+		viewport()->update(LaneRect(lane));
+		event->accept();
+		return;
+	}
+
+	pressedLane = lane;
+	emit LaneSelected(lane, event->modifiers());
+	event->accept();
+}
+
+void MeterWall::mouseReleaseEvent(QMouseEvent *event)
+{
+	int lane = pressedLane;
+	pressedLane = -1;
+
+	if (event->button() == Qt::LeftButton && lane >= 0 && lane == LaneAt(event->position().toPoint())) {
+		emit LaneClicked(lane, event->modifiers());
+		event->accept();
+		return;
+	}
+	QAbstractScrollArea::mouseReleaseEvent(event);
+}
+
+void MeterWall::contextMenuEvent(QContextMenuEvent *event)
+{
+	emit LaneContextMenu(LaneAt(event->pos()));
+	event->accept();
+}
+
+void MeterWall::OBSVolumeLevel(void *data, const float magnitude[MAX_AUDIO_CHANNELS],
+			       const float peak[MAX_AUDIO_CHANNELS], const float inputPeak[MAX_AUDIO_CHANNELS])
+{
+	// Wait-free, safe to call from the audio thread
+	static_cast<LevelHandoff *>(data)->publish(os_gettime_ns(), magnitude, peak, inputPeak);
+}
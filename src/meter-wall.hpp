@@ -0,0 +1,133 @@
+#pragma once
+
+#include "level-handoff.hpp"
+
+#include <obs.hpp>
+
+#include <QAbstractScrollArea>
+#include <QColor>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class MeterBallistics;
+class VolumeMeter;
+
+// Compact view of every audio source as one thin meter lane, painted by a
+// single widget. Replaces a MixerItem widget tree and VolumeMeter per source
+// when the collection is too large for per-strip widgets.
+//
+// Per-lane state lives in flat arrays indexed by lane. Lanes follow the order
+// handed to SetSources(); the dock keeps that in sync with its own list, so a
+// lane index is also the index of the source's MixerItem. Only lanes inside
+// the viewport have their volmeter attached.
+class MeterWall : public QAbstractScrollArea {
+	Q_OBJECT
+
+public:
+	explicit MeterWall(std::shared_ptr<MeterBallistics> ballistics, QWidget *parent = nullptr);
+	~MeterWall();
+
+	// Lanes follow the given order; sources already shown keep their meter state
+	void SetSources(const std::vector<OBSSource> &sources);
+	void RemoveSource(obs_source_t *source);
+	void Clear(bool isShutdown = false);
+	int LaneCount() const { return static_cast<int>(sources.size()); }
+
+	void SetLaneSelected(obs_source_t *source, bool selected);
+	void ClearSelection();
+	void RefreshNames();
+
+	// Metering runs for on-screen lanes only, and only while active
+	void SetMeteringActive(bool active);
+	bool IsMeteringActive() const { return meteringActive && !sources.empty(); }
+
+	// Driven by the dock's shared meter clock around MeterBallistics::process()
+	void PullLevels(uint64_t ts);
+	void Refresh();
+
+signals:
+	void LaneSelected(int lane, Qt::KeyboardModifiers modifiers);
+	void LaneClicked(int lane, Qt::KeyboardModifiers modifiers);
+	void LaneContextMenu(int lane);
+
+protected:
+	void paintEvent(QPaintEvent *event) override;
+	void resizeEvent(QResizeEvent *event) override;
+	void scrollContentsBy(int dx, int dy) override;
+	void changeEvent(QEvent *event) override;
+	void showEvent(QShowEvent *event) override;
+	void mousePressEvent(QMouseEvent *event) override;
+	void mouseReleaseEvent(QMouseEvent *event) override;
+	void contextMenuEvent(QContextMenuEvent *event) override;
+
+private:
+	void AddLane(const OBSSource &source);
+	void ReleaseLane(size_t lane, bool isShutdown);
+	void SetLaneMetering(size_t lane, bool active);
+	void UpdateMeteredLanes();
+	void UpdateScrollRange();
+	void UpdateLaneHeight();
+	void UpdateColors();
+	void ResetDisplayedState(size_t lane);
+	void PermuteLanes(const std::vector<size_t> &from);
+
+	int LaneAt(const QPoint &pos) const;
+	QRect LaneRect(int lane) const;
+	int NameWidth() const;
+	int MeterX() const;
+	int MeterLength() const;
+	int LevelToPosition(float level, int length) const;
+	void PaintLane(QPainter &painter, size_t lane, const QRect &rect);
+
+	static void OBSVolumeLevel(void *data, const float magnitude[MAX_AUDIO_CHANNELS],
+				   const float peak[MAX_AUDIO_CHANNELS], const float inputPeak[MAX_AUDIO_CHANNELS]);
+
+	std::shared_ptr<MeterBallistics> ballistics;
+	int channels = 0;
+
+	// Per-lane state, one entry per lane
+	std::vector<OBSSource> sources;
+	std::vector<QString> names;
+	std::vector<OBSVolMeter> volmeters;
+	// Stable addresses: the audio thread publishes into these through the volmeter callback
+	std::vector<std::unique_ptr<LevelHandoff>> handoffs;
+	std::vector<int> ballisticsSlots;
+	std::vector<uint8_t> muted;
+	std::vector<uint8_t> selected;
+	std::vector<uint8_t> metering;
+	std::vector<uint8_t> idle;
+
+	// Last painted positions in pixels, lanes * channels entries each
+	std::vector<int> displayedMagnitude;
+	std::vector<int> displayedPeak;
+	std::vector<int> displayedPeakHold;
+
+	std::unordered_map<obs_source_t *, size_t> laneBySource;
+
+	bool meteringActive = false;
+	int firstMeteredLane = 0;
+	int lastMeteredLane = -1;
+	int laneHeight = 0;
+	int pressedLane = -1;
+
+	float minimumLevel = -60.0f;
+	float warningLevel = -20.0f;
+	float errorLevel = -9.0f;
+
+	// Colors, read back from a hidden VolumeMeter child that themes style like the strip
+	// meters; refreshed when the wall is shown and after style changes
+	VolumeMeter *themeProbe = nullptr;
+	QColor backgroundNominalColor{0x26, 0x7f, 0x26};
+	QColor backgroundWarningColor{0x7f, 0x7f, 0x26};
+	QColor backgroundErrorColor{0x7f, 0x26, 0x26};
+	QColor foregroundNominalColor{0x4c, 0xff, 0x4c};
+	QColor foregroundWarningColor{0xff, 0xff, 0x4c};
+	QColor foregroundErrorColor{0xff, 0x4c, 0x4c};
+	QColor magnitudeColor{0x00, 0x00, 0x00};
+	// VolumeMeter's disabled colors are not themeable either
+	QColor mutedBackgroundColor{75, 75, 75};
+	QColor mutedForegroundColor{150, 150, 150};
+};
@@ -1,5 +1,6 @@
 #include "mixer-item.hpp"
 #include "volume-meter.hpp"
+#include "mixer-strip-layout.hpp"
 
 #include <obs-module.h>
 #include <obs-frontend-api.h>
@@ -8,42 +9,208 @@
 #include <QAction>
 #include <QMainWindow>
 #include <QMouseEvent>
+#include <QApplication>
+#include <QDrag>
+#include <QMimeData>
+#include <QPointer>
+#include <QPainter>
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
-MixerItem::MixerItem(OBSSource source_, bool vertical_, QWidget *parent)
+// One audio output tick (AUDIO_OUTPUT_FRAMES at the current sample rate); the fader
+// can't take effect any faster than this
+static int AudioTickMs()
+{
+	uint32_t sampleRate = audio_output_get_sample_rate(obs_get_audio());
+	if (!sampleRate)
+		return 21;
+	return std::max(1, static_cast<int>(AUDIO_OUTPUT_FRAMES * 1000 / sampleRate));
+}
+
+MixerItem::MixerItem(OBSSource source_, std::shared_ptr<MeterBallistics> ballistics_, bool vertical_,
+		     bool deferContent, QWidget *parent)
 	: QFrame(parent),
 	  source(source_),
-	  vertical(false)  // Start as horizontal, SetupUI creates horizontal layout
+	  ballistics(std::move(ballistics_)),
+	  vertical(vertical_)
 {
+	// UUIDs never change for a source's lifetime; cache it for order lookups
+	const char *uuid = obs_source_get_uuid(source);
+	sourceUUID = uuid ? uuid : "";
+
+	setFrameShape(QFrame::StyledPanel);
+	setObjectName(GetSourceName());
+	ApplyOrientation();
+
+	faderWriteTimer = new QTimer(this);
+	faderWriteTimer->setSingleShot(true);
+	connect(faderWriteTimer, &QTimer::timeout, this, [this]() {
+		// Trailing edge: apply the latest value and keep throttling while it moves
+		if (pendingSliderValue < 0)
+			return;
+		FlushSliderWrite();
+		faderWriteTimer->start(AudioTickMs());
+	});
+
+	// In a virtualized list the dock creates content once the strip nears the viewport
+	if (!deferContent)
+		CreateContent();
+}
+
+MixerItem::~MixerItem()
+{
+	Cleanup();
+}
+
+void MixerItem::CreateContent()
+{
+	if (hasContent || !source)
+		return;
+
+	hasContent = true;
+
 	// Create OBS fader and volmeter
 	obs_fader = obs_fader_create(OBS_FADER_LOG);
 	obs_volmeter = obs_volmeter_create(OBS_FADER_LOG);
 
 	obs_fader_attach_source(obs_fader, source);
 	obs_volmeter_attach_source(obs_volmeter, source);
+	meteringActive = true;
 
 	SetupUI();
+
 	SetupSignals();
 
 	// Initialize volume display
 	UpdateVolumeLabel();
 
-	// Apply vertical layout if requested
-	if (vertical_) {
-		SetVertical(true);
-	}
+	updateGeometry();
 }
 
-MixerItem::~MixerItem()
+void MixerItem::ReleaseContent()
 {
-	Cleanup();
+	// Never tear down widgets while one of them is running a menu
+	if (!hasContent || contentBusy)
+		return;
+
+	// Keep the strip's footprint so the scroll range doesn't change
+	placeholderSize = QFrame::sizeHint();
+
+	ReleaseHandles(false);
+
+	delete layout();
+	stripLayout = nullptr;
+	const QList<QWidget *> children = findChildren<QWidget *>(QString(), Qt::FindDirectChildrenOnly);
+	for (QWidget *child : children)
+		delete child;
+
+	nameLabel = nullptr;
+	volLabel = nullptr;
+	volMeter = nullptr;
+	slider = nullptr;
+	muteCheckbox = nullptr;
+	configButton = nullptr;
+
+	hasContent = false;
+	updateGeometry();
+}
+
+void MixerItem::SetPlaceholderSize(const QSize &size)
+{
+	if (placeholderSize == size)
+		return;
+
+	placeholderSize = size;
+	if (!hasContent)
+		updateGeometry();
+}
+
+QSize MixerItem::sizeHint() const
+{
+	if (!hasContent)
+		return placeholderSize;
+	return QFrame::sizeHint();
+}
+
+QSize MixerItem::minimumSizeHint() const
+{
+	if (!hasContent)
+		return vertical ? QSize(placeholderSize.width(), 0) : QSize(0, placeholderSize.height());
+	return QFrame::minimumSizeHint();
 }
 
 void MixerItem::Cleanup(bool isShutdown)
 {
-	if (!obs_fader)
+	if (!source && !obs_fader)
 		return; // Already cleaned up
 
+	ReleaseHandles(isShutdown);
+	source = nullptr;
+}
+
+void MixerItem::Unbind()
+{
+	if (!source)
+		return;
+
+	// Finish a throttled drag on the source it was meant for
+	faderWriteTimer->stop();
+	FlushSliderWrite();
+
+	// Let go of the source but keep the fader, volmeter and widgets for reuse
+	signalConnections.clear();
+	if (obs_fader) {
+		obs_fader_detach_source(obs_fader);
+		if (meteringActive)
+			obs_volmeter_detach_source(obs_volmeter);
+	}
+	meteringActive = false;
+
+	if (volMeter)
+		volMeter->clearLevels();
+
+	SetSelected(false);
+	source = nullptr;
+	sourceUUID.clear();
+}
+
+void MixerItem::Rebind(OBSSource source_, bool vertical_)
+{
+	Unbind();
+
+	source = source_;
+	const char *uuid = obs_source_get_uuid(source);
+	sourceUUID = uuid ? uuid : "";
+	setObjectName(GetSourceName());
+
+	SetVertical(vertical_);
+
+	if (!hasContent)
+		return;
+
+	obs_fader_attach_source(obs_fader, source);
+	obs_volmeter_attach_source(obs_volmeter, source);
+	meteringActive = true;
+	ConnectSourceSignals();
+
+	// Replace everything the previous source left on screen
+	nameLabel->setText(GetSourceName());
+	VolumeMuted();
+	VolumeChanged();
+}
+
+void MixerItem::ReleaseHandles(bool isShutdown)
+{
+	if (!obs_fader)
+		return;
+
+	// Don't lose the last slider position of a throttled drag
+	faderWriteTimer->stop();
+	if (!isShutdown)
+		FlushSliderWrite();
+	pendingSliderValue = -1;
+
 	DisconnectSignals();
 
 	// During shutdown, don't touch fader/volmeter - sources are already
@@ -51,7 +218,8 @@ void MixerItem::Cleanup(bool isShutdown)
 	// our pointers and let the process cleanup handle it.
 	if (!isShutdown) {
 		obs_fader_detach_source(obs_fader);
-		obs_volmeter_detach_source(obs_volmeter);
+		if (meteringActive)
+			obs_volmeter_detach_source(obs_volmeter);
 		// OBSFader and OBSVolMeter are RAII wrappers (OBSPtr) that auto-destroy
 		// when assigned nullptr - do NOT manually call obs_fader_destroy/obs_volmeter_destroy
 		// as that causes a double-free crash!
@@ -59,13 +227,26 @@ void MixerItem::Cleanup(bool isShutdown)
 
 	obs_fader = nullptr;
 	obs_volmeter = nullptr;
-	source = nullptr;
+	meteringActive = false;
 }
 
-QString MixerItem::GetSourceUUID() const
+void MixerItem::SetMeteringActive(bool active)
 {
-	const char *uuid = obs_source_get_uuid(source);
-	return uuid ? QString::fromUtf8(uuid) : QString();
+	if (!obs_volmeter || meteringActive == active)
+		return;
+
+	meteringActive = active;
+
+	if (active) {
+		obs_volmeter_attach_source(obs_volmeter, source);
+	} else {
+		// Detaching stops libobs from computing levels for this source at all
+		obs_volmeter_detach_source(obs_volmeter);
+
+		// Drop the stale levels so the meter resumes from silence when shown again
+		if (volMeter)
+			volMeter->clearLevels();
+	}
 }
 
 QString MixerItem::GetSourceName() const
@@ -76,26 +257,9 @@ QString MixerItem::GetSourceName() const
 
 void MixerItem::SetupUI()
 {
-	setFrameShape(QFrame::StyledPanel);
-	setObjectName(GetSourceName());
-
-	QVBoxLayout *mainLayout = new QVBoxLayout(this);
-	mainLayout->setContentsMargins(6, 6, 6, 6);
-	mainLayout->setSpacing(2);
-
-	// Row 1: Name
-	QHBoxLayout *nameRow = new QHBoxLayout();
-	nameRow->setSpacing(4);
-
 	nameLabel = new QLabel(GetSourceName());
-	nameRow->addWidget(nameLabel, 1);
-
-	mainLayout->addLayout(nameRow);
-
-	// Row 2: Config button + Volume meter + dB label
-	// [config] [========meter========] [dB]
-	QHBoxLayout *meterRow = new QHBoxLayout();
-	meterRow->setSpacing(4);
+	nameLabel->setWordWrap(false);
+	nameLabel->setTextFormat(Qt::PlainText);
 
 	configButton = new QPushButton();
 	configButton->setProperty("class", "icon-dots-vert");
@@ -103,24 +267,12 @@ void MixerItem::SetupUI()
 	configButton->setFlat(true);
 	configButton->setToolTip(obs_module_text("BetterAudioMixer.Config"));
 	connect(configButton, &QPushButton::clicked, this, &MixerItem::OnConfigClicked);
-	meterRow->addWidget(configButton);
 
-	volMeter = new VolumeMeter(this);
+	volMeter = new VolumeMeter(ballistics, this);
 	volMeter->setMinimumHeight(20);
-	volMeter->muted = obs_source_muted(source);
-	meterRow->addWidget(volMeter, 1);
+	volMeter->setMuted(obs_source_muted(source));
 
 	volLabel = new QLabel();
-	volLabel->setFixedWidth(50);
-	volLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-	meterRow->addWidget(volLabel);
-
-	mainLayout->addLayout(meterRow);
-
-	// Row 3: Mute checkbox + Slider
-	// [mute  ] [========slider=======]
-	QHBoxLayout *sliderRow = new QHBoxLayout();
-	sliderRow->setSpacing(4);
 
 	muteCheckbox = new QCheckBox();
 	muteCheckbox->setProperty("class", "indicator-mute");
@@ -128,23 +280,24 @@ void MixerItem::SetupUI()
 	muteCheckbox->setToolTip(obs_module_text("BetterAudioMixer.Mute"));
 	muteCheckbox->setChecked(obs_source_muted(source));
 	connect(muteCheckbox, &QCheckBox::toggled, this, &MixerItem::OnMuteToggled);
-	sliderRow->addWidget(muteCheckbox);
 
 	slider = new QSlider(Qt::Horizontal);
 	slider->setMinimum(0);
 	slider->setMaximum(static_cast<int>(FADER_PRECISION));
 	slider->setValue(static_cast<int>(obs_fader_get_deflection(obs_fader) * FADER_PRECISION));
 	connect(slider, &QSlider::valueChanged, this, &MixerItem::OnSliderChanged);
-	sliderRow->addWidget(slider, 1);
-
-	// Spacer to align slider end with meter end (same width as volLabel)
-	QWidget *sliderSpacer = new QWidget();
-	sliderSpacer->setFixedWidth(50);
-	sliderRow->addWidget(sliderSpacer);
-
-	mainLayout->addLayout(sliderRow);
-
-	setLayout(mainLayout);
+	connect(slider, &QSlider::sliderReleased, this, &MixerItem::FlushSliderWrite);
+
+	// One flat layout for both orientations; switching only recomputes geometry
+	stripLayout = new MixerStripLayout(this);
+	stripLayout->setWidget(MixerStripLayout::Name, nameLabel);
+	stripLayout->setWidget(MixerStripLayout::Config, configButton);
+	stripLayout->setWidget(MixerStripLayout::Meter, volMeter);
+	stripLayout->setWidget(MixerStripLayout::VolumeLabel, volLabel);
+	stripLayout->setWidget(MixerStripLayout::Mute, muteCheckbox);
+	stripLayout->setWidget(MixerStripLayout::Slider, slider);
+
+	ApplyContentOrientation();
 }
 
 void MixerItem::SetupSignals()
@@ -155,15 +308,14 @@ void MixerItem::SetupSignals()
 	// Volmeter callback for level display
 	obs_volmeter_add_callback(obs_volmeter, OBSVolumeLevel, this);
 
+	ConnectSourceSignals();
+}
+
+void MixerItem::ConnectSourceSignals()
+{
 	// Source mute signal
 	signal_handler_t *handler = obs_source_get_signal_handler(source);
-	signalConnections.emplace_back(handler, "mute",
-		[](void *data, calldata_t *cd) {
-			bool muted = calldata_bool(cd, "muted");
-			QMetaObject::invokeMethod(static_cast<MixerItem *>(data),
-				"VolumeMuted", Qt::QueuedConnection,
-				Q_ARG(bool, muted));
-		}, this);
+	signalConnections.emplace_back(handler, "mute", OBSVolumeMuted, this);
 }
 
 void MixerItem::DisconnectSignals()
@@ -176,16 +328,20 @@ void MixerItem::DisconnectSignals()
 void MixerItem::OBSVolumeChanged(void *data, float db)
 {
 	Q_UNUSED(db);
-	QMetaObject::invokeMethod(static_cast<MixerItem *>(data),
-		"VolumeChanged", Qt::QueuedConnection);
+
+	// Fades and script ramps call this continuously; only queue when nothing is outstanding
+	MixerItem *item = static_cast<MixerItem *>(data);
+	if (item->volumeUpdatePending.exchange(true))
+		return;
+
+	QMetaObject::invokeMethod(item, "VolumeChanged", Qt::QueuedConnection);
 }
 
 void MixerItem::OBSVolumeMuted(void *data, calldata_t *calldata)
 {
-	bool muted = calldata_bool(calldata, "muted");
+	Q_UNUSED(calldata);
 	QMetaObject::invokeMethod(static_cast<MixerItem *>(data),
-		"VolumeMuted", Qt::QueuedConnection,
-		Q_ARG(bool, muted));
+		"VolumeMuted", Qt::QueuedConnection);
 }
 
 void MixerItem::OBSVolumeLevel(void *data,
@@ -195,29 +351,46 @@ void MixerItem::OBSVolumeLevel(void *data,
 {
 	MixerItem *item = static_cast<MixerItem *>(data);
 	if (item->volMeter) {
-		// setLevels is thread-safe (uses mutex internally)
+		// setLevels is wait-free, safe to call from the audio thread
 		item->volMeter->setLevels(magnitude, peak, inputPeak);
 	}
 }
 
 void MixerItem::VolumeChanged()
 {
-	float deflection = obs_fader_get_deflection(obs_fader);
-	slider->blockSignals(true);
-	slider->setValue(static_cast<int>(deflection * FADER_PRECISION));
-	slider->blockSignals(false);
+	// Cleared before reading so a change that lands after the read queues another update
+	volumeUpdatePending = false;
+
+	// May still be queued after the content was released
+	if (!hasContent)
+		return;
+
+	// While dragging, the slider is the source of the fader's value; don't pull it back
+	if (!slider->isSliderDown()) {
+		float deflection = obs_fader_get_deflection(obs_fader);
+		slider->blockSignals(true);
+		slider->setValue(static_cast<int>(deflection * FADER_PRECISION));
+		slider->blockSignals(false);
+	}
 
 	UpdateVolumeLabel();
 }
 
-void MixerItem::VolumeMuted(bool muted)
+void MixerItem::VolumeMuted()
 {
+	if (!hasContent || !source)
+		return;
+
+	// Read the current state: a recycled strip may still receive a notification
+	// queued for the source it was bound to before
+	bool muted = obs_source_muted(source);
+
 	muteCheckbox->blockSignals(true);
 	muteCheckbox->setChecked(muted);
 	muteCheckbox->blockSignals(false);
 
 	if (volMeter) {
-		volMeter->muted = muted;
+		volMeter->setMuted(muted);
 	}
 }
 
@@ -234,6 +407,29 @@ void MixerItem::UpdateVolumeLabel()
 
 void MixerItem::OnSliderChanged(int value)
 {
+	pendingSliderValue = value;
+
+	// Leading edge writes immediately; changes within the tick wait for the timer
+	if (!faderWriteTimer->isActive()) {
+		FlushSliderWrite();
+		faderWriteTimer->start(AudioTickMs());
+	}
+}
+
+void MixerItem::FlushSliderWrite()
+{
+	if (pendingSliderValue < 0)
+		return;
+
+	ApplyDeflection(pendingSliderValue);
+	pendingSliderValue = -1;
+}
+
+void MixerItem::ApplyDeflection(int value)
+{
+	if (!obs_fader)
+		return;
+
 	float deflection = static_cast<float>(value) / FADER_PRECISION;
 	obs_fader_set_deflection(obs_fader, deflection);
 	UpdateVolumeLabel();
@@ -246,7 +442,8 @@ void MixerItem::OnMuteToggled(bool checked)
 
 void MixerItem::RefreshName()
 {
-	nameLabel->setText(GetSourceName());
+	if (nameLabel)
+		nameLabel->setText(GetSourceName());
 	setObjectName(GetSourceName());
 }
 
@@ -256,145 +453,116 @@ void MixerItem::SetVertical(bool vert)
 		return;
 
 	vertical = vert;
+	ApplyOrientation();
 
-	// Remove the old layout
-	QLayout *oldLayout = layout();
-	if (oldLayout) {
-		// Reparent all widgets to this before deleting layout
-		QList<QWidget *> widgets;
-		widgets << nameLabel << configButton << volMeter << volLabel << muteCheckbox << slider;
-		for (QWidget *w : widgets) {
-			if (w)
-				w->setParent(this);
-		}
-		delete oldLayout;
-	}
+	if (hasContent)
+		ApplyContentOrientation();
+}
 
+void MixerItem::ApplyOrientation()
+{
+	// Strip-level sizing, applied whether or not the content exists
 	if (vertical) {
-		// Vertical layout: narrow column with vertical slider/meter
-		// [Name Label]
-		// [Config] [Mute]
-		// [Meter | Slider] side by side
-		// [dB Label]
-
-		QVBoxLayout *mainLayout = new QVBoxLayout(this);
-		mainLayout->setContentsMargins(4, 4, 4, 4);
-		mainLayout->setSpacing(2);
-
-		// Name at top - use small fixed font size for vertical mode
-		QFont smallFont = nameLabel->font();
-		smallFont.setPixelSize(10);  // Small fixed pixel size for vertical layout
-		nameLabel->setFont(smallFont);
-		nameLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-		nameLabel->setWordWrap(false);
-		nameLabel->setTextFormat(Qt::PlainText);
-		mainLayout->addWidget(nameLabel);
-
-		// Config and mute buttons row
-		QHBoxLayout *buttonRow = new QHBoxLayout();
-		buttonRow->setSpacing(2);
-		buttonRow->addWidget(configButton);
-		buttonRow->addStretch();
-		buttonRow->addWidget(muteCheckbox);
-		mainLayout->addLayout(buttonRow);
-
-		// Meter and slider side by side
-		QHBoxLayout *meterSliderRow = new QHBoxLayout();
-		meterSliderRow->setSpacing(4);
-
-		// Vertical meter on left
-		volMeter->setVertical(true);
-		meterSliderRow->addWidget(volMeter);
-
-		// Vertical slider on right
-		slider->setOrientation(Qt::Vertical);
-		slider->setMinimumHeight(60);
-		meterSliderRow->addWidget(slider);
-
-		mainLayout->addLayout(meterSliderRow, 1);
-
-		// Volume label at bottom
-		volLabel->setAlignment(Qt::AlignCenter);
-		volLabel->setFixedWidth(QWIDGETSIZE_MAX);  // Allow full width
-		mainLayout->addWidget(volLabel);
-
-		// Set size policy for vertical mode
 		setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
 		setMinimumWidth(90);
 		setMaximumWidth(120);
 	} else {
-		// Horizontal layout: wide row with horizontal slider/meter
-		// Same as original SetupUI layout
-		QVBoxLayout *mainLayout = new QVBoxLayout(this);
-		mainLayout->setContentsMargins(6, 6, 6, 6);
-		mainLayout->setSpacing(2);
-
-		// Row 1: Name - restore normal font size
-		QFont normalFont = nameLabel->font();
-		normalFont.setPixelSize(13);  // Normal pixel size for horizontal layout
-		nameLabel->setFont(normalFont);
-		QHBoxLayout *nameRow = new QHBoxLayout();
-		nameRow->setSpacing(4);
-		nameLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-		nameRow->addWidget(nameLabel, 1);
-		mainLayout->addLayout(nameRow);
-
-		// Row 2: Config button + Volume meter + dB label
-		QHBoxLayout *meterRow = new QHBoxLayout();
-		meterRow->setSpacing(4);
-		meterRow->addWidget(configButton);
-		volMeter->setVertical(false);
-		meterRow->addWidget(volMeter, 1);
-		volLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-		meterRow->addWidget(volLabel);
-		mainLayout->addLayout(meterRow);
-
-		// Row 3: Mute checkbox + Slider + Spacer
-		QHBoxLayout *sliderRow = new QHBoxLayout();
-		sliderRow->setSpacing(4);
-		sliderRow->addWidget(muteCheckbox);
-		slider->setOrientation(Qt::Horizontal);
-		slider->setMinimumHeight(0);
-		sliderRow->addWidget(slider, 1);
-		// Spacer to align slider end with meter end
-		QWidget *sliderSpacer = new QWidget();
-		sliderSpacer->setFixedWidth(50);
-		sliderRow->addWidget(sliderSpacer);
-		mainLayout->addLayout(sliderRow);
-
-		// Set size policy for horizontal mode
 		setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 		setMinimumWidth(0);
 		setMaximumWidth(QWIDGETSIZE_MAX);
 	}
 }
 
+void MixerItem::ApplyContentOrientation()
+{
+	// Per-widget properties only; the strip layout repositions the same widgets
+	QFont nameFont;
+	if (vertical)
+		nameFont.setPixelSize(10);
+	nameLabel->setFont(nameFont);
+	nameLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+
+	volMeter->setVertical(vertical);
+	slider->setOrientation(vertical ? Qt::Vertical : Qt::Horizontal);
+	slider->setMinimumHeight(vertical ? 60 : 0);
+	volLabel->setAlignment(vertical ? Qt::AlignCenter : (Qt::AlignRight | Qt::AlignVCenter));
+
+	stripLayout->setVertical(vertical);
+}
+
 void MixerItem::SetSelected(bool sel)
 {
 	if (selected == sel)
 		return;
 
 	selected = sel;
-	UpdateSelectionStyle();
+
+	// Painted rather than styled: a per-widget stylesheet would re-polish the whole strip
+	update();
 }
 
-void MixerItem::UpdateSelectionStyle()
+void MixerItem::paintEvent(QPaintEvent *event)
 {
-	if (selected) {
-		setStyleSheet("MixerItem { border: 2px solid palette(highlight); }");
-	} else {
-		setStyleSheet("");
-	}
+	QFrame::paintEvent(event);
+
+	if (!selected)
+		return;
+
+	// 2px highlight border drawn over the frame
+	QPainter painter(this);
+	QPen pen(palette().color(QPalette::Highlight), 2);
+	pen.setJoinStyle(Qt::MiterJoin);
+	painter.setPen(pen);
+	painter.setBrush(Qt::NoBrush);
+	painter.drawRect(QRectF(rect()).adjusted(1, 1, -1, -1));
 }
 
 void MixerItem::mousePressEvent(QMouseEvent *event)
 {
 	if (event->button() == Qt::LeftButton) {
-		emit Selected(this);
+		emit Selected(this, event->modifiers());
+		dragStartPos = event->position().toPoint();
+		dragArmed = true;
 	}
 	QFrame::mousePressEvent(event);
 }
 
+void MixerItem::mouseReleaseEvent(QMouseEvent *event)
+{
+	// A press that didn't turn into a drag is a click
+	if (event->button() == Qt::LeftButton && dragArmed) {
+		dragArmed = false;
+		emit Clicked(this, event->modifiers());
+	}
+	QFrame::mouseReleaseEvent(event);
+}
+
+void MixerItem::mouseMoveEvent(QMouseEvent *event)
+{
+	if (!dragArmed || !(event->buttons() & Qt::LeftButton) ||
+	    (event->position().toPoint() - dragStartPos).manhattanLength() < QApplication::startDragDistance()) {
+		QFrame::mouseMoveEvent(event);
+		return;
+	}
+	dragArmed = false;
+
+	// The dock accepts the drop and performs the move
+	auto *mimeData = new QMimeData();
+	mimeData->setData(MIXER_ITEM_MIME_TYPE, QByteArray::fromStdString(sourceUUID));
+
+	QDrag *drag = new QDrag(this);
+	drag->setMimeData(mimeData);
+	drag->setPixmap(grab());
+	drag->setHotSpot(dragStartPos);
+
+	// Keep the widgets alive while the drag runs its own event loop
+	QPointer<MixerItem> guard(this);
+	contentBusy = true;
+	drag->exec(Qt::MoveAction);
+	if (guard)
+		contentBusy = false;
+}
+
 void MixerItem::OnConfigClicked()
 {
 	QMenu menu(this);
@@ -415,7 +583,9 @@ void MixerItem::OnConfigClicked()
 	QAction *advAudioAction = menu.addAction(obs_module_text("BetterAudioMixer.AdvancedAudio"));
 	connect(advAudioAction, &QAction::triggered, this, &MixerItem::OnAdvancedAudioClicked);
 
+	contentBusy = true;
 	menu.exec(QCursor::pos());
+	contentBusy = false;
 }
 
 void MixerItem::OnHideClicked()
@@ -7,42 +7,76 @@
 #include <QPushButton>
 #include <QSlider>
 #include <QCheckBox>
-#include <QVBoxLayout>
-#include <QHBoxLayout>
 #include <QMenu>
+#include <QTimer>
 
+#include <atomic>
+#include <memory>
+#include <string>
 #include <vector>
 
+// Drag payload: the dragged strip's source UUID
+#define MIXER_ITEM_MIME_TYPE "application/x-reorderable-audio-mixer-item"
+
 class VolumeMeter;
+class MeterBallistics;
+class MixerStripLayout;
 
 class MixerItem : public QFrame {
 	Q_OBJECT
 
 public:
-	explicit MixerItem(OBSSource source, bool vertical = false, QWidget *parent = nullptr);
+	explicit MixerItem(OBSSource source, std::shared_ptr<MeterBallistics> ballistics, bool vertical = false,
+			   bool deferContent = false, QWidget *parent = nullptr);
 	~MixerItem();
 
 	obs_source_t *GetSource() const { return source; }
-	QString GetSourceUUID() const;
+	const std::string &GetSourceUUID() const { return sourceUUID; }
 	QString GetSourceName() const;
+	VolumeMeter *GetVolumeMeter() const { return volMeter; }
 
 	void SetVertical(bool vertical);
 	void RefreshName();
 	void Cleanup(bool isShutdown = false);
 
+	// Pooling: Unbind() detaches from the source but keeps the fader, volmeter and
+	// widget tree; Rebind() attaches them to another source and refreshes the display
+	void Unbind();
+	void Rebind(OBSSource source, bool vertical);
+	bool IsContentBusy() const { return contentBusy; }
+
+	// Widget tree, fader and volmeter; a virtualized dock only keeps these
+	// for strips in or near the viewport
+	void CreateContent();
+	void ReleaseContent();
+	bool HasContent() const { return hasContent; }
+	void SetPlaceholderSize(const QSize &size);
+
+	QSize sizeHint() const override;
+	QSize minimumSizeHint() const override;
+
+	// Attach/detach the volmeter while the strip is on or off screen
+	void SetMeteringActive(bool active);
+	bool IsMeteringActive() const { return meteringActive; }
+
 	void SetSelected(bool selected);
 	bool IsSelected() const { return selected; }
 
 signals:
 	void HideRequested(MixerItem *item);
-	void Selected(MixerItem *item);
+	void Selected(MixerItem *item, Qt::KeyboardModifiers modifiers);
+	void Clicked(MixerItem *item, Qt::KeyboardModifiers modifiers);
 
 protected:
+	void paintEvent(QPaintEvent *event) override;
 	void mousePressEvent(QMouseEvent *event) override;
+	void mouseMoveEvent(QMouseEvent *event) override;
+	void mouseReleaseEvent(QMouseEvent *event) override;
 
 private slots:
 	void OnMuteToggled(bool checked);
 	void OnSliderChanged(int value);
+	void FlushSliderWrite();
 	void OnConfigClicked();
 	void OnHideClicked();
 	void OnFiltersClicked();
@@ -50,14 +84,18 @@ private slots:
 	void OnAdvancedAudioClicked();
 
 	void VolumeChanged();
-	void VolumeMuted(bool muted);
+	void VolumeMuted();
 
 private:
 	void SetupUI();
+	void ApplyOrientation();
+	void ApplyContentOrientation();
+	void ReleaseHandles(bool isShutdown);
 	void SetupSignals();
+	void ConnectSourceSignals();
 	void DisconnectSignals();
 	void UpdateVolumeLabel();
-	void UpdateSelectionStyle();
+	void ApplyDeflection(int value);
 
 	static void OBSVolumeChanged(void *data, float db);
 	static void OBSVolumeMuted(void *data, calldata_t *calldata);
@@ -68,6 +106,8 @@ private:
 
 private:
 	OBSSource source;
+	std::string sourceUUID;
+	std::shared_ptr<MeterBallistics> ballistics;
 	std::vector<OBSSignal> signalConnections;
 
 	// UI elements
@@ -77,13 +117,28 @@ private:
 	QSlider *slider = nullptr;
 	QCheckBox *muteCheckbox = nullptr;
 	QPushButton *configButton = nullptr;
+	MixerStripLayout *stripLayout = nullptr;
 
 	// OBS handles
 	OBSFader obs_fader;
 	OBSVolMeter obs_volmeter;
 
+	// At most one queued VolumeChanged per item; set by the fader callback thread
+	std::atomic<bool> volumeUpdatePending{false};
+
+	// Slider drags write to the fader at most once per audio tick; the latest value
+	// is applied when the timer fires and when the slider is released
+	QTimer *faderWriteTimer = nullptr;
+	int pendingSliderValue = -1;
+
 	bool vertical = false;
 	bool selected = false;
+	bool meteringActive = false;
+	bool hasContent = false;
+	bool contentBusy = false;
+	QSize placeholderSize;
+	QPoint dragStartPos;
+	bool dragArmed = false;
 
 	static constexpr float FADER_PRECISION = 4096.0f;
 };
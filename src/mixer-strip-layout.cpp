@@ -0,0 +1,219 @@
+#include "mixer-strip-layout.hpp"
+
+#include <QWidget>
+
+#include <algorithm>
+
+// Width of the dB label column; the slider row leaves the same gap so both bars end together
+#define LABEL_COLUMN_WIDTH 50
+
+// Spacing between rows and between widgets within a row
+#define ROW_SPACING 2
+#define HORIZONTAL_ITEM_SPACING 4
+#define VERTICAL_BUTTON_SPACING 2
+#define VERTICAL_ITEM_SPACING 4
+
+// Outer margins per orientation
+#define HORIZONTAL_MARGIN 6
+#define VERTICAL_MARGIN 4
+
+MixerStripLayout::MixerStripLayout(QWidget *parent) : QLayout(parent)
+{
+	setContentsMargins(HORIZONTAL_MARGIN, HORIZONTAL_MARGIN, HORIZONTAL_MARGIN, HORIZONTAL_MARGIN);
+}
+
+MixerStripLayout::~MixerStripLayout()
+{
+	for (QLayoutItem *&item : items) {
+		delete item;
+		item = nullptr;
+	}
+}
+
+void MixerStripLayout::setWidget(Role role, QWidget *widget)
+{
+	delete items[role];
+	items[role] = nullptr;
+
+	if (widget) {
+		addChildWidget(widget);
+		items[role] = new QWidgetItem(widget);
+	}
+	invalidate();
+}
+
+void MixerStripLayout::setVertical(bool vertical_)
+{
+	if (vertical == vertical_)
+		return;
+
+	vertical = vertical_;
+	const int margin = vertical ? VERTICAL_MARGIN : HORIZONTAL_MARGIN;
+	setContentsMargins(margin, margin, margin, margin);
+	invalidate();
+}
+
+void MixerStripLayout::addItem(QLayoutItem *item)
+{
+	// Plain addWidget() fills the roles in declaration order
+	for (QLayoutItem *&slot : items) {
+		if (!slot) {
+			slot = item;
+			invalidate();
+			return;
+		}
+	}
+	delete item;
+}
+
+QLayoutItem *MixerStripLayout::itemAt(int index) const
+{
+	for (QLayoutItem *item : items) {
+		if (item && index-- == 0)
+			return item;
+	}
+	return nullptr;
+}
+
+QLayoutItem *MixerStripLayout::takeAt(int index)
+{
+	for (QLayoutItem *&item : items) {
+		if (item && index-- == 0) {
+			QLayoutItem *taken = item;
+			item = nullptr;
+			invalidate();
+			return taken;
+		}
+	}
+	return nullptr;
+}
+
+int MixerStripLayout::count() const
+{
+	return static_cast<int>(std::count_if(std::begin(items), std::end(items),
+					       [](QLayoutItem *item) { return item != nullptr; }));
+}
+
+void MixerStripLayout::invalidate()
+{
+	cachedSizeHint = QSize();
+	cachedMinimumSize = QSize();
+	QLayout::invalidate();
+}
+
+QSize MixerStripLayout::sizeHint() const
+{
+	if (!cachedSizeHint.isValid())
+		cachedSizeHint = calculateSize(false);
+	return cachedSizeHint;
+}
+
+QSize MixerStripLayout::minimumSize() const
+{
+	if (!cachedMinimumSize.isValid())
+		cachedMinimumSize = calculateSize(true);
+	return cachedMinimumSize;
+}
+
+Qt::Orientations MixerStripLayout::expandingDirections() const
+{
+	return vertical ? Qt::Vertical : Qt::Horizontal;
+}
+
+QSize MixerStripLayout::itemSize(Role role, bool minimum) const
+{
+	QLayoutItem *item = items[role];
+	if (!item || item->isEmpty())
+		return QSize(0, 0);
+	return minimum ? item->minimumSize() : item->sizeHint();
+}
+
+QSize MixerStripLayout::calculateSize(bool minimum) const
+{
+	const QSize name = itemSize(Name, minimum);
+	const QSize config = itemSize(Config, minimum);
+	const QSize meter = itemSize(Meter, minimum);
+	const QSize label = itemSize(VolumeLabel, minimum);
+	const QSize mute = itemSize(Mute, minimum);
+	const QSize slider = itemSize(Slider, minimum);
+
+	int width;
+	int height;
+	if (vertical) {
+		width = std::max({name.width(), config.width() + VERTICAL_BUTTON_SPACING + mute.width(),
+				  meter.width() + VERTICAL_ITEM_SPACING + slider.width(), label.width()});
+		height = name.height() + ROW_SPACING + std::max(config.height(), mute.height()) + ROW_SPACING +
+			 std::max(meter.height(), slider.height()) + ROW_SPACING + label.height();
+	} else {
+		const int tail = HORIZONTAL_ITEM_SPACING + LABEL_COLUMN_WIDTH;
+		width = std::max({name.width(), config.width() + HORIZONTAL_ITEM_SPACING + meter.width() + tail,
+				  mute.width() + HORIZONTAL_ITEM_SPACING + slider.width() + tail});
+		height = name.height() + ROW_SPACING + std::max({config.height(), meter.height(), label.height()}) +
+			 ROW_SPACING + std::max(mute.height(), slider.height());
+	}
+
+	const QMargins margins = contentsMargins();
+	return QSize(width + margins.left() + margins.right(), height + margins.top() + margins.bottom());
+}
+
+void MixerStripLayout::place(Role role, const QRect &cell)
+{
+	QLayoutItem *item = items[role];
+	if (!item)
+		return;
+
+	// Fixed-size widgets (buttons, checkbox) sit centred in their cell; nothing spills out of it
+	QSize size = cell.size().boundedTo(item->maximumSize()).expandedTo(item->minimumSize()).boundedTo(cell.size());
+	QPoint topLeft(cell.x() + (cell.width() - size.width()) / 2, cell.y() + (cell.height() - size.height()) / 2);
+	item->setGeometry(QRect(topLeft, size));
+}
+
+void MixerStripLayout::setGeometry(const QRect &rect)
+{
+	QLayout::setGeometry(rect);
+
+	const QRect r = contentsRect();
+	const int x = r.x();
+	const int w = r.width();
+	int y = r.y();
+
+	const int nameHeight = itemSize(Name, false).height();
+	place(Name, QRect(x, y, w, nameHeight));
+	y += nameHeight + ROW_SPACING;
+
+	const QSize config = itemSize(Config, false);
+	const QSize mute = itemSize(Mute, false);
+
+	if (vertical) {
+		const int buttonHeight = std::max(config.height(), mute.height());
+		place(Config, QRect(x, y, config.width(), buttonHeight));
+		place(Mute, QRect(x + w - mute.width(), y, mute.width(), buttonHeight));
+		y += buttonHeight + ROW_SPACING;
+
+		// Meter and slider share whatever height is left above the dB label
+		const int labelHeight = itemSize(VolumeLabel, false).height();
+		const int minBars = std::max(itemSize(Meter, true).height(), itemSize(Slider, true).height());
+		const int barHeight = std::max(r.bottom() + 1 - y - ROW_SPACING - labelHeight, minBars);
+		const int sliderWidth = itemSize(Slider, false).width();
+		place(Meter, QRect(x, y, std::max(w - sliderWidth - VERTICAL_ITEM_SPACING, 0), barHeight));
+		place(Slider, QRect(x + w - sliderWidth, y, sliderWidth, barHeight));
+		y += barHeight + ROW_SPACING;
+
+		place(VolumeLabel, QRect(x, y, w, labelHeight));
+	} else {
+		const int tail = HORIZONTAL_ITEM_SPACING + LABEL_COLUMN_WIDTH;
+
+		const int meterRowHeight = std::max({config.height(), itemSize(Meter, false).height(),
+						     itemSize(VolumeLabel, false).height()});
+		place(Config, QRect(x, y, config.width(), meterRowHeight));
+		const int meterX = x + config.width() + HORIZONTAL_ITEM_SPACING;
+		place(Meter, QRect(meterX, y, std::max(x + w - tail - meterX, 0), meterRowHeight));
+		place(VolumeLabel, QRect(x + w - LABEL_COLUMN_WIDTH, y, LABEL_COLUMN_WIDTH, meterRowHeight));
+		y += meterRowHeight + ROW_SPACING;
+
+		const int sliderRowHeight = std::max(mute.height(), itemSize(Slider, false).height());
+		place(Mute, QRect(x, y, mute.width(), sliderRowHeight));
+		const int sliderX = x + mute.width() + HORIZONTAL_ITEM_SPACING;
+		place(Slider, QRect(sliderX, y, std::max(x + w - tail - sliderX, 0), sliderRowHeight));
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QLayout>
+
+// Flat layout for one mixer strip that arranges a fixed set of widgets by role,
+// either as horizontal rows or as a narrow vertical column.
+//
+// Switching orientation only recomputes geometry: the widgets stay in place as
+// children of the strip and no nested layouts are created or destroyed.
+//
+// Horizontal:                    Vertical:
+//   [Name                   ]      [Name       ]
+//   [Config][Meter ][VolLabel]     [Config Mute]
+//   [Mute  ][Slider][        ]     [Meter|Slid ]
+//                                  [VolLabel   ]
+class MixerStripLayout : public QLayout {
+public:
+	enum Role { Name, Config, Meter, VolumeLabel, Mute, Slider, RoleCount };
+
+	explicit MixerStripLayout(QWidget *parent = nullptr);
+	~MixerStripLayout();
+
+	void setWidget(Role role, QWidget *widget);
+
+	void setVertical(bool vertical);
+	bool isVertical() const { return vertical; }
+
+	// QLayout
+	void addItem(QLayoutItem *item) override;
+	QLayoutItem *itemAt(int index) const override;
+	QLayoutItem *takeAt(int index) override;
+	int count() const override;
+	QSize sizeHint() const override;
+	QSize minimumSize() const override;
+	void setGeometry(const QRect &rect) override;
+	Qt::Orientations expandingDirections() const override;
+	void invalidate() override;
+
+private:
+	QSize itemSize(Role role, bool minimum) const;
+	QSize calculateSize(bool minimum) const;
+	void place(Role role, const QRect &cell);
+
+	QLayoutItem *items[RoleCount] = {};
+	bool vertical = false;
+
+	mutable QSize cachedSizeHint;
+	mutable QSize cachedMinimumSize;
+};
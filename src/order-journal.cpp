@@ -0,0 +1,165 @@
+#include "order-journal.hpp"
+
+#include <obs-module.h>
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+// Byte offsets of the encoded fields
+#define RECORD_DATA_OFFSET 16
+#define RECORD_CHECKSUM_OFFSET 44
+
+static_assert(RECORD_DATA_OFFSET + OrderJournal::NAME_CHUNK == RECORD_CHECKSUM_OFFSET &&
+		      RECORD_CHECKSUM_OFFSET + 4 == OrderJournal::RECORD_SIZE,
+	      "journal records must stay 48 bytes");
+
+static void PutU32(uint8_t *out, uint32_t value)
+{
+	for (size_t i = 0; i < sizeof(value); i++)
+		out[i] = uint8_t(value >> (8 * i));
+}
+
+static uint32_t GetU32(const uint8_t *in)
+{
+	uint32_t value = 0;
+	for (size_t i = 0; i < sizeof(value); i++)
+		value |= uint32_t(in[i]) << (8 * i);
+	return value;
+}
+
+// Covers every byte before the checksum
+static uint32_t Checksum(const uint8_t *bytes)
+{
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < RECORD_CHECKSUM_OFFSET; i++) {
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+	return hash;
+}
+
+// Little-endian on disk whatever the host, with the checksum filled in
+static void Encode(const OrderJournal::Record &record, uint8_t *out)
+{
+	PutU32(out, record.op);
+	PutU32(out + 4, record.generation);
+	PutU32(out + 8, record.value);
+	PutU32(out + 12, record.length);
+	std::memcpy(out + RECORD_DATA_OFFSET, record.data, sizeof(record.data));
+	PutU32(out + RECORD_CHECKSUM_OFFSET, Checksum(out));
+}
+
+static OrderJournal::Record Decode(const uint8_t *in)
+{
+	OrderJournal::Record record;
+	record.op = GetU32(in);
+	record.generation = GetU32(in + 4);
+	record.value = GetU32(in + 8);
+	record.length = GetU32(in + 12);
+	std::memcpy(record.data, in + RECORD_DATA_OFFSET, sizeof(record.data));
+	return record;
+}
+
+OrderJournal::Record OrderJournal::Make(Op op, uint32_t value, const UuidTable::Bytes *id)
+{
+	Record record;
+	record.op = static_cast<uint32_t>(op);
+	record.value = value;
+	if (id) {
+		std::memcpy(record.data, id->data(), id->size());
+		record.length = uint32_t(id->size());
+	}
+	return record;
+}
+
+void OrderJournal::AppendName(std::vector<Record> &records, Op op, const std::string &name)
+{
+	// Always ends with a short chunk, which is empty when the name fills the last one
+	size_t offset = 0;
+	for (;;) {
+		size_t length = std::min(name.size() - offset, NAME_CHUNK);
+		Record record = Make(op, uint32_t(offset));
+		std::memcpy(record.data, name.data() + offset, length);
+		record.length = uint32_t(length);
+		records.push_back(record);
+
+		offset += length;
+		if (length < NAME_CHUNK)
+			break;
+	}
+}
+
+UuidTable::Bytes OrderJournal::GetId(const Record &record)
+{
+	UuidTable::Bytes id;
+	std::memcpy(id.data(), record.data, id.size());
+	return id;
+}
+
+bool OrderJournal::Read(const std::string &path, std::vector<Record> &records)
+{
+	records.clear();
+
+	FILE *f = os_fopen(path.c_str(), "rb");
+	if (!f)
+		return false;
+
+	int64_t size = os_fgetsize(f);
+	if (size <= 0) {
+		fclose(f);
+		return false;
+	}
+	records.reserve(size_t(size) / RECORD_SIZE);
+
+	uint8_t bytes[RECORD_SIZE];
+	while (fread(bytes, RECORD_SIZE, 1, f) == 1) {
+		Record record = Decode(bytes);
+		if (GetU32(bytes + RECORD_CHECKSUM_OFFSET) != Checksum(bytes) || record.length > NAME_CHUNK) {
+			blog(LOG_WARNING, "[Reorderable Audio Mixer] Order journal is damaged after %zu records",
+			     records.size());
+			break;
+		}
+		records.push_back(record);
+	}
+	fclose(f);
+
+	return true;
+}
+
+bool OrderJournal::Append(const std::string &path, const std::vector<Record> &records, size_t first,
+			  uint32_t generation)
+{
+	if (first >= records.size())
+		return true;
+
+	if (!file)
+		file = os_fopen(path.c_str(), "ab");
+	if (!file)
+		return false;
+
+	bool ok = true;
+	uint8_t bytes[RECORD_SIZE];
+	for (size_t i = first; i < records.size() && ok; i++) {
+		Record record = records[i];
+		record.generation = generation;
+		Encode(record, bytes);
+		ok = fwrite(bytes, RECORD_SIZE, 1, file) == 1;
+	}
+	return fflush(file) == 0 && ok;
+}
+
+bool OrderJournal::Reset(const std::string &path)
+{
+	Close();
+	file = os_fopen(path.c_str(), "wb");
+	return file != nullptr;
+}
+
+void OrderJournal::Close()
+{
+	if (file) {
+		fclose(file);
+		file = nullptr;
+	}
+}
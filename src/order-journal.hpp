@@ -0,0 +1,67 @@
+#pragma once
+
+#include "uuid-table.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Append-only log of order changes made since the last snapshot (order.journal).
+//
+// Every record is 48 bytes, so a change costs one small append instead of a
+// rewrite of order.bin: u32 op, generation, value and length (little-endian),
+// 28 data bytes, then a u32 checksum of everything before it. Records apply to the collection and scene named by the
+// most recent Collection/Scene records, whose names are split into chunks of
+// up to NAME_CHUNK bytes; a chunk shorter than that ends the name.
+//
+// Each record carries the generation of the snapshot it follows. Replay skips
+// records from other generations, so a crash between writing a new snapshot
+// and truncating the journal can't apply the same change twice. A record
+// whose checksum doesn't match (a torn write) ends the journal.
+class OrderJournal {
+public:
+	enum class Op : uint32_t {
+		Collection = 1, // name chunk; value is its byte offset
+		Scene,          // name chunk; value is its byte offset
+		Add,            // append id unless present
+		Remove,         // remove id
+		Move,           // move id to position value
+		Place,          // put id into slot value (one step of a subset reorder)
+		Clear,          // empty the scene's order
+		Preferences,    // value holds the packed preference flags
+	};
+
+	struct Record {
+		uint32_t op = 0;
+		uint32_t generation = 0;
+		uint32_t value = 0;
+		uint32_t length = 0;
+		uint8_t data[28] = {};
+	};
+
+	static constexpr size_t RECORD_SIZE = 48;
+	static constexpr size_t NAME_CHUNK = sizeof(Record::data);
+
+	static Record Make(Op op, uint32_t value = 0, const UuidTable::Bytes *id = nullptr);
+	static void AppendName(std::vector<Record> &records, Op op, const std::string &name);
+	static UuidTable::Bytes GetId(const Record &record);
+
+	// Every intact record in the file, in order. True if the file has any
+	// content, which then needs a Reset() before anything is appended to it.
+	static bool Read(const std::string &path, std::vector<Record> &records);
+
+	OrderJournal() = default;
+	OrderJournal(const OrderJournal &) = delete;
+	OrderJournal &operator=(const OrderJournal &) = delete;
+	~OrderJournal() { Close(); }
+
+	// Writes records[first..] stamped with generation and flushes them to the OS
+	bool Append(const std::string &path, const std::vector<Record> &records, size_t first, uint32_t generation);
+	// Empties the journal once a snapshot holds everything in it
+	bool Reset(const std::string &path);
+	void Close();
+
+private:
+	FILE *file = nullptr;
+};
@@ -4,24 +4,55 @@
 #include <util/platform.h>
 
 #include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <unordered_set>
+#include <utility>
 
-OrderManager::OrderManager()
+// Bursts of changes within this window are written to disk once
+#define ORDER_SAVE_DEBOUNCE_MS 500
+
+// Binary store, and the JSON config it replaced (still read once to migrate)
+#define ORDER_STORE_FILE "order.bin"
+#define ORDER_JSON_FILE "order.json"
+
+// Changes since the last snapshot, and how many of them (~192 KiB) trigger compaction
+#define ORDER_JOURNAL_FILE "order.journal"
+#define ORDER_JOURNAL_COMPACT_RECORDS 4096
+
+// Decoded collections kept in memory, counting the current one; the rest live as encoded blocks
+#define ORDER_RESIDENT_COLLECTIONS 3
+
+// Encoded cost of one order entry and the fixed part of a scene
+#define ORDER_ENTRY_BYTES 4
+#define ORDER_SCENE_BYTES 12
+
+#define SECONDS_PER_DAY 86400
+
+static uint32_t Today()
 {
+	return static_cast<uint32_t>(time(nullptr) / SECONDS_PER_DAY);
 }
 
+OrderManager::OrderManager(std::string configDirectory_) : configDirectory(std::move(configDirectory_)) {}
+
 OrderManager::~OrderManager()
 {
+	Flush();
 }
 
-std::string OrderManager::GetConfigPath() const
+std::string OrderManager::GetConfigPath(const char *file) const
 {
-	char *path = obs_module_config_path("order.json");
+	if (!configDirectory.empty())
+		return configDirectory + "/" + file;
+
+	char *path = obs_module_config_path(file);
 	std::string result = path ? path : "";
 	bfree(path);
 	return result;
 }
 
-void OrderManager::EnsureDirectory(const std::string &path) const
+void OrderManager::EnsureDirectory(const std::string &path)
 {
 	// Find last separator
 	size_t pos = path.find_last_of("/\\");
@@ -33,102 +64,472 @@ void OrderManager::EnsureDirectory(const std::string &path) const
 
 void OrderManager::Load()
 {
-	std::string path = GetConfigPath();
+	std::string path = GetConfigPath(ORDER_STORE_FILE);
 	if (path.empty())
 		return;
 
-	obs_data_t *data = obs_data_create_from_json_file_safe(path.c_str(), "bak");
-	if (!data) {
+	orderByCollectionScene.clear();
+	uuids = UuidTable();
+	dirty = false;
+	generation = 0;
+	journalRecords = 0;
+	unsavedRecords.clear();
+	journalContext = false;
+	journalPath = GetConfigPath(ORDER_JOURNAL_FILE);
+	sourceSeen.clear();
+	collectionSeen.clear();
+	changedCollections.clear();
+
+	// Only the store's index is read here; collections are decoded when first used
+	uint64_t start = os_gettime_ns();
+	if (store.Open(path)) {
+		ApplyPreferences(store.GetPreferences());
+		generation = store.GetGeneration();
+		blog(LOG_INFO, "[Reorderable Audio Mixer] Opened order store in %.2f ms (%zu collections, %zu bytes mapped)",
+		     double(os_gettime_ns() - start) / 1000000.0, store.GetCollectionNames().size(),
+		     store.GetFileSize());
+
+		for (const std::string &name : store.GetCollectionNames()) {
+			collectionSeen[name] = store.GetCollectionSeen(name);
+		}
+
+		// Older files are decoded in full once; eviction below re-encodes them in the current format
+		if (store.NeedsUpgrade()) {
+			for (const std::string &name : store.GetCollectionNames()) {
+				EnsureCollectionLoaded(name);
+				changedCollections.insert(name);
+			}
+			dirty = true;
+		}
+	} else if (ReadJson(GetConfigPath(ORDER_JSON_FILE), true)) {
+		// One-time migration from the JSON config, which is left in place as a backup
+		blog(LOG_INFO, "[Reorderable Audio Mixer] Migrating %s to %s", ORDER_JSON_FILE, ORDER_STORE_FILE);
+		dirty = true;
+	} else {
 		blog(LOG_INFO, "[Reorderable Audio Mixer] No saved order found");
-		return;
 	}
+	journalGeneration = generation;
 
-	orderByCollectionScene.clear();
+	// Whatever was journaled is folded into a new snapshot right away, which also empties the journal
+	if (ReplayJournal())
+		dirty = true;
+
+	EnsureCollectionLoaded(currentCollection);
+	EvictIdleCollections();
+	if (dirty)
+		Save();
+}
+
+bool OrderManager::ReplayJournal()
+{
+	std::vector<OrderJournal::Record> records;
+	if (!OrderJournal::Read(journalPath, records))
+		return false;
+
+	using Op = OrderJournal::Op;
+	std::string collection;
+	std::string scene;
+	SceneOrder *order = nullptr;
+	size_t applied = 0;
+
+	for (const OrderJournal::Record &record : records) {
+		// Left over from before the snapshot we loaded
+		if (record.generation != generation)
+			continue;
+
+		Op op = static_cast<Op>(record.op);
+		switch (op) {
+		case Op::Collection:
+		case Op::Scene: {
+			std::string &name = op == Op::Collection ? collection : scene;
+			if (record.value == 0)
+				name.clear();
+			name.append(reinterpret_cast<const char *>(record.data), record.length);
+			order = nullptr;
+			break;
+		}
+		case Op::Preferences:
+			ApplyPreferences(OrderStore::UnpackPreferences(record.value));
+			break;
+		case Op::Clear:
+		case Op::Add:
+		case Op::Remove:
+		case Op::Move:
+		case Op::Place: {
+			if (!order) {
+				EnsureCollectionLoaded(collection);
+				changedCollections.insert(collection);
+				order = &orderByCollectionScene[collection][scene];
+			}
+
+			if (op == Op::Clear) {
+				order->Clear();
+				break;
+			}
+
+			SourceHandle handle = uuids.Intern(OrderJournal::GetId(record));
+			if (op == Op::Add)
+				order->Add(handle);
+			else if (op == Op::Remove)
+				order->Remove(handle);
+			else if (op == Op::Move)
+				order->Move(handle, record.value);
+			else
+				order->Place(record.value, handle);
+			break;
+		}
+		default:
+			continue;
+		}
+		applied++;
+	}
+
+	// Replay indexed every scene it touched; only the current one keeps its index
+	for (auto &collPair : orderByCollectionScene) {
+		for (auto &scenePair : collPair.second) {
+			scenePair.second.DropIndex();
+		}
+	}
+
+	blog(LOG_INFO, "[Reorderable Audio Mixer] Replayed %zu of %zu order journal records", applied, records.size());
+	return true;
+}
+
+bool OrderManager::ImportJson(const std::string &path)
+{
+	if (!ReadJson(path, false))
+		return false;
 
-	// Load global preferences
-	verticalLayout = obs_data_get_bool(data, "verticalLayout");
+	blog(LOG_INFO, "[Reorderable Audio Mixer] Imported order from %s", path.c_str());
+	EvictIdleCollections();
+	dirty = true;
+	return true;
+}
+
+bool OrderManager::ExportJson(const std::string &path)
+{
+	// Export covers every collection, so decode the ones still only in the store
+	for (const std::string &name : store.GetCollectionNames()) {
+		EnsureCollectionLoaded(name);
+	}
+
+	std::unique_ptr<SaveSnapshot> snapshot = BuildSnapshot();
+	if (!snapshot)
+		return false;
+	snapshot->path = path;
+	EvictIdleCollections();
+
+	EnsureDirectory(path);
+	return WriteJson(*snapshot);
+}
+
+bool OrderManager::ReadJson(const std::string &path, bool withPreferences)
+{
+	if (path.empty())
+		return false;
+
+	obs_data_t *data = obs_data_create_from_json_file_safe(path.c_str(), "bak");
+	if (!data)
+		return false;
 
 	int version = (int)obs_data_get_int(data, "version");
+	if (version < 2) {
+		// Version 1 (old global order format) - ignore old data, start fresh
+		blog(LOG_INFO, "[Reorderable Audio Mixer] Old config format (v%d), starting fresh with per-scene ordering", version);
+		obs_data_release(data);
+		return false;
+	}
 
-	if (version >= 2) {
-		// Version 2: per-scene ordering
-		obs_data_t *collections = obs_data_get_obj(data, "collections");
-		if (collections) {
-			obs_data_item_t *collItem = obs_data_first(collections);
-			while (collItem) {
-				const char *collectionName = obs_data_item_get_name(collItem);
-				obs_data_t *collectionData = obs_data_item_get_obj(collItem);
-
-				if (collectionData) {
-					obs_data_t *scenes = obs_data_get_obj(collectionData, "scenes");
-					if (scenes) {
-						obs_data_item_t *sceneItem = obs_data_first(scenes);
-						while (sceneItem) {
-							const char *sceneName = obs_data_item_get_name(sceneItem);
-							obs_data_t *sceneData = obs_data_item_get_obj(sceneItem);
-
-							if (sceneData) {
-								obs_data_array_t *orderArray = obs_data_get_array(sceneData, "order");
-								if (orderArray) {
-									std::vector<std::string> order;
-									size_t count = obs_data_array_count(orderArray);
-									for (size_t i = 0; i < count; i++) {
-										obs_data_t *entry = obs_data_array_item(orderArray, i);
-										const char *uuid = obs_data_get_string(entry, "uuid");
-										if (uuid && *uuid) {
-											order.push_back(uuid);
-										}
-										obs_data_release(entry);
+	if (withPreferences) {
+		verticalLayout = obs_data_get_bool(data, "verticalLayout");
+		virtualizedList = obs_data_get_bool(data, "virtualizedList");
+		meterWall = obs_data_get_bool(data, "meterWall");
+	}
+
+	// Version 2: per-scene ordering. Collections in the file replace the ones in memory.
+	std::map<std::string, std::map<std::string, SceneOrder>> parsed;
+	obs_data_t *collections = obs_data_get_obj(data, "collections");
+	if (collections) {
+		obs_data_item_t *collItem = obs_data_first(collections);
+		while (collItem) {
+			const char *collectionName = obs_data_item_get_name(collItem);
+			obs_data_t *collectionData = obs_data_item_get_obj(collItem);
+
+			if (collectionData) {
+				obs_data_t *scenes = obs_data_get_obj(collectionData, "scenes");
+				if (scenes) {
+					obs_data_item_t *sceneItem = obs_data_first(scenes);
+					while (sceneItem) {
+						const char *sceneName = obs_data_item_get_name(sceneItem);
+						obs_data_t *sceneData = obs_data_item_get_obj(sceneItem);
+
+						if (sceneData) {
+							obs_data_array_t *orderArray = obs_data_get_array(sceneData, "order");
+							if (orderArray) {
+								SceneOrder &order = parsed[collectionName][sceneName];
+								size_t count = obs_data_array_count(orderArray);
+								auto handles = std::make_shared<std::vector<SourceHandle>>();
+								handles->reserve(count);
+								for (size_t i = 0; i < count; i++) {
+									obs_data_t *entry = obs_data_array_item(orderArray, i);
+									const char *uuid = obs_data_get_string(entry, "uuid");
+									SourceHandle handle = uuid ? uuids.Intern(uuid) : UuidTable::INVALID_HANDLE;
+									if (handle != UuidTable::INVALID_HANDLE) {
+										handles->push_back(handle);
 									}
-									orderByCollectionScene[collectionName][sceneName] = order;
-									obs_data_array_release(orderArray);
+									obs_data_release(entry);
 								}
-								obs_data_release(sceneData);
+								order.handles = std::move(handles);
+								obs_data_array_release(orderArray);
 							}
-							obs_data_item_next(&sceneItem);
+							obs_data_release(sceneData);
 						}
-						obs_data_release(scenes);
+						obs_data_item_next(&sceneItem);
 					}
-					obs_data_release(collectionData);
+					obs_data_release(scenes);
 				}
-				obs_data_item_next(&collItem);
+				obs_data_release(collectionData);
 			}
-			obs_data_release(collections);
+			obs_data_item_next(&collItem);
 		}
-		blog(LOG_INFO, "[Reorderable Audio Mixer] Loaded per-scene order config (v%d)", version);
-	} else {
-		// Version 1 (old global order format) - ignore old data, start fresh
-		blog(LOG_INFO, "[Reorderable Audio Mixer] Old config format (v%d), starting fresh with per-scene ordering", version);
+		obs_data_release(collections);
 	}
 
+	for (auto &collection : parsed) {
+		orderByCollectionScene[collection.first] = std::move(collection.second);
+		changedCollections.insert(collection.first);
+	}
+
+	blog(LOG_INFO, "[Reorderable Audio Mixer] Loaded per-scene order config (v%d)", version);
 	obs_data_release(data);
+	return true;
 }
 
 void OrderManager::Save()
 {
-	std::string path = GetConfigPath();
-	if (path.empty())
+	CheckFailedSnapshot();
+	if (unsavedRecords.empty() && !dirty)
 		return;
 
-	EnsureDirectory(path);
+	// Fold the journal into a new snapshot once it has grown enough
+	journalRecords += unsavedRecords.size();
+	std::unique_ptr<SaveSnapshot> snapshot;
+	if (dirty || journalRecords >= ORDER_JOURNAL_COMPACT_RECORDS)
+		snapshot = TakeSnapshot();
+
+	std::unique_lock<std::mutex> lock(saverMutex);
+	QueuePending(std::move(snapshot));
+	if (saverStopping) {
+		// Saver already shut down, nothing left to hand off to
+		std::unique_ptr<SaveSnapshot> pending = std::move(pendingSnapshot);
+		std::vector<OrderJournal::Record> records;
+		records.swap(pendingRecords);
+		size_t covered = pendingCovered;
+		pendingCovered = 0;
+		lock.unlock();
+		WriteBatch(pending.get(), records, covered);
+		return;
+	}
+
+	if (!saverThread.joinable())
+		saverThread = std::thread(&OrderManager::SaverLoop, this);
+	lock.unlock();
+	saverCond.notify_one();
+}
+
+void OrderManager::Flush()
+{
+	// A cleanup pass still running only reads copies; it is cancelled and its result dropped
+	{
+		std::unique_lock<std::mutex> lock(reconcile->mutex);
+		reconcile->generation++;
+		reconcile->result.reset();
+		reconcile->idle.wait(lock, [this] { return reconcile->running == 0; });
+	}
+
+	CheckFailedSnapshot();
 
+	// Leave an empty journal behind when shutting down cleanly
+	journalRecords += unsavedRecords.size();
+	std::unique_ptr<SaveSnapshot> snapshot;
+	if (dirty || journalRecords > 0)
+		snapshot = TakeSnapshot();
+	{
+		std::lock_guard<std::mutex> lock(saverMutex);
+		QueuePending(std::move(snapshot));
+		saverStopping = true;
+	}
+	saverCond.notify_one();
+
+	// The saver writes anything pending immediately once stopping
+	if (saverThread.joinable())
+		saverThread.join();
+
+	// Only reached with something pending if the saver was never started
+	std::unique_ptr<SaveSnapshot> remaining;
+	std::vector<OrderJournal::Record> records;
+	size_t covered;
+	{
+		std::lock_guard<std::mutex> lock(saverMutex);
+		remaining = std::move(pendingSnapshot);
+		records.swap(pendingRecords);
+		covered = pendingCovered;
+		pendingCovered = 0;
+	}
+	if (remaining || !records.empty())
+		WriteBatch(remaining.get(), records, covered);
+	journal.Close();
+}
+
+void OrderManager::QueuePending(std::unique_ptr<SaveSnapshot> snapshot)
+{
+	pendingRecords.insert(pendingRecords.end(), unsavedRecords.begin(), unsavedRecords.end());
+	unsavedRecords.clear();
+
+	// A newer snapshot replaces one that hasn't been written yet, and holds every record queued before it
+	if (snapshot) {
+		pendingSnapshot = std::move(snapshot);
+		pendingCovered = pendingRecords.size();
+	}
+}
+
+void OrderManager::CheckFailedSnapshot()
+{
+	std::lock_guard<std::mutex> lock(saverMutex);
+	// A newer snapshot already queued holds the same changes
+	if (failedGeneration && failedGeneration == generation)
+		dirty = true;
+	failedGeneration = 0;
+}
+
+std::unique_ptr<OrderManager::SaveSnapshot> OrderManager::TakeSnapshot()
+{
+	std::unique_ptr<SaveSnapshot> snapshot = BuildSnapshot();
+	if (!snapshot)
+		return nullptr;
+
+	// Cleared once the snapshot is queued; CheckFailedSnapshot() sets it again if the write fails
+	snapshot->generation = ++generation;
+	dirty = false;
+	journalRecords = 0;
+
+	// The journal written after this snapshot has to name its collection and scene again
+	journalContext = false;
+	return snapshot;
+}
+
+std::unique_ptr<OrderManager::SaveSnapshot> OrderManager::BuildSnapshot()
+{
+	auto snapshot = std::make_unique<SaveSnapshot>();
+	snapshot->path = GetConfigPath(ORDER_STORE_FILE);
+	if (snapshot->path.empty())
+		return nullptr;
+
+	snapshot->preferences = GetPreferences();
+
+	// Orders and IDs are shared, not copied; later edits copy-on-write
+	snapshot->ids = uuids.Share();
+	snapshot->collections.reserve(orderByCollectionScene.size());
+	for (const auto &collPair : orderByCollectionScene) {
+		snapshot->collections.push_back(PackCollection(collPair.first));
+	}
+
+	// Collections never decoded are written back from the store as they are
+	for (const std::string &name : store.GetCollectionNames()) {
+		if (orderByCollectionScene.count(name))
+			continue;
+		OrderStore::Collection collection;
+		if (store.GetRawCollection(name, collection)) {
+			collection.seen.collection = CollectionSeen(name);
+			snapshot->collections.push_back(std::move(collection));
+		}
+	}
+
+	return snapshot;
+}
+
+void OrderManager::SaverLoop()
+{
+	std::unique_lock<std::mutex> lock(saverMutex);
+	for (;;) {
+		saverCond.wait(lock, [this] { return pendingSnapshot || !pendingRecords.empty() || saverStopping; });
+		if (!pendingSnapshot && pendingRecords.empty())
+			break;
+
+		// Let further changes coalesce into this write unless we're shutting down
+		saverCond.wait_for(lock, std::chrono::milliseconds(ORDER_SAVE_DEBOUNCE_MS),
+				   [this] { return saverStopping; });
+
+		std::unique_ptr<SaveSnapshot> snapshot = std::move(pendingSnapshot);
+		std::vector<OrderJournal::Record> records;
+		records.swap(pendingRecords);
+		size_t covered = pendingCovered;
+		pendingCovered = 0;
+		lock.unlock();
+		WriteBatch(snapshot.get(), records, covered);
+		lock.lock();
+	}
+}
+
+void OrderManager::WriteBatch(const SaveSnapshot *snapshot, const std::vector<OrderJournal::Record> &records,
+			      size_t covered)
+{
+	size_t first = 0;
+	if (snapshot && WriteSnapshot(*snapshot)) {
+		// Records stamped with the old generation are skipped by replay, so a crash
+		// before the reset below can't apply them twice
+		journalGeneration = snapshot->generation;
+		if (!journal.Reset(journalPath))
+			blog(LOG_WARNING, "[Reorderable Audio Mixer] Failed to reset order journal");
+		first = covered;
+	} else if (snapshot) {
+		// The records it covered still go to the journal below, but changes that were
+		// never journaled only exist in memory; the UI thread snapshots them again
+		std::lock_guard<std::mutex> lock(saverMutex);
+		failedGeneration = snapshot->generation;
+	}
+
+	if (!journal.Append(journalPath, records, first, journalGeneration))
+		blog(LOG_ERROR, "[Reorderable Audio Mixer] Failed to write order journal");
+}
+
+bool OrderManager::WriteSnapshot(const SaveSnapshot &snapshot)
+{
+	EnsureDirectory(snapshot.path);
+
+	if (!OrderStore::Write(snapshot.path, snapshot.generation, snapshot.preferences, *snapshot.ids,
+			       snapshot.collections)) {
+		blog(LOG_ERROR, "[Reorderable Audio Mixer] Failed to save order config");
+		return false;
+	}
+
+	blog(LOG_INFO, "[Reorderable Audio Mixer] Saved order config");
+	return true;
+}
+
+bool OrderManager::WriteJson(const SaveSnapshot &snapshot)
+{
 	obs_data_t *data = obs_data_create();
 	obs_data_set_int(data, "version", 2);
-	obs_data_set_bool(data, "verticalLayout", verticalLayout);
+	obs_data_set_bool(data, "verticalLayout", snapshot.preferences.verticalLayout);
+	obs_data_set_bool(data, "virtualizedList", snapshot.preferences.virtualizedList);
+	obs_data_set_bool(data, "meterWall", snapshot.preferences.meterWall);
 
 	obs_data_t *collections = obs_data_create();
 
-	for (const auto &collPair : orderByCollectionScene) {
+	for (const OrderStore::Collection &collection : snapshot.collections) {
 		obs_data_t *collectionData = obs_data_create();
 		obs_data_t *scenes = obs_data_create();
 
-		for (const auto &scenePair : collPair.second) {
+		for (const auto &scenePair : collection.scenes) {
 			obs_data_t *sceneData = obs_data_create();
 			obs_data_array_t *orderArray = obs_data_array_create();
 
-			for (const std::string &uuid : scenePair.second) {
+			for (SourceHandle handle : *scenePair.second) {
+				if (handle >= snapshot.ids->size())
+					continue;
 				obs_data_t *entry = obs_data_create();
-				obs_data_set_string(entry, "uuid", uuid.c_str());
+				obs_data_set_string(entry, "uuid", UuidTable::Format((*snapshot.ids)[handle]).c_str());
 				obs_data_array_push_back(orderArray, entry);
 				obs_data_release(entry);
 			}
@@ -141,7 +542,7 @@ void OrderManager::Save()
 		}
 
 		obs_data_set_obj(collectionData, "scenes", scenes);
-		obs_data_set_obj(collections, collPair.first.c_str(), collectionData);
+		obs_data_set_obj(collections, collection.name.c_str(), collectionData);
 
 		obs_data_release(scenes);
 		obs_data_release(collectionData);
@@ -150,60 +551,717 @@ void OrderManager::Save()
 	obs_data_set_obj(data, "collections", collections);
 	obs_data_release(collections);
 
-	if (obs_data_save_json_safe(data, path.c_str(), "tmp", "bak")) {
-		blog(LOG_INFO, "[Reorderable Audio Mixer] Saved order config");
+	bool saved = obs_data_save_json_safe(data, snapshot.path.c_str(), "tmp", "bak");
+	if (saved) {
+		blog(LOG_INFO, "[Reorderable Audio Mixer] Exported order to %s", snapshot.path.c_str());
 	} else {
-		blog(LOG_ERROR, "[Reorderable Audio Mixer] Failed to save order config");
+		blog(LOG_ERROR, "[Reorderable Audio Mixer] Failed to export order to %s", snapshot.path.c_str());
 	}
 
 	obs_data_release(data);
+	return saved;
 }
 
 void OrderManager::SetCurrentCollection(const std::string &collectionName)
 {
+	if (collectionName != currentCollection)
+		DropCurrentIndex();
 	currentCollection = collectionName;
+	collectionUse[currentCollection] = ++useCounter;
+	EnsureCollectionLoaded(currentCollection);
+	EvictIdleCollections();
+}
+
+void OrderManager::EnsureCollectionLoaded(const std::string &name)
+{
+	if (orderByCollectionScene.count(name) || !store.HasCollection(name))
+		return;
+
+	uint64_t start = os_gettime_ns();
+	OrderStore::SceneHandles scenes;
+	OrderStore::SeenDays seen;
+	if (!store.ReadCollection(name, uuids, scenes, seen))
+		return;
+
+	auto &collection = orderByCollectionScene[name];
+	for (auto &scene : scenes) {
+		SceneOrder &order = collection[scene.first];
+		order.handles = std::make_shared<std::vector<SourceHandle>>(std::move(scene.second));
+		auto day = seen.scenes.find(scene.first);
+		order.seen = day != seen.scenes.end() ? day->second : 0;
+	}
+	sourceSeen[name] = std::move(seen.ids);
+
+	blog(LOG_INFO, "[Reorderable Audio Mixer] Loaded collection '%s' in %.2f ms (%zu scenes, ~%zu bytes)",
+	     name.c_str(), double(os_gettime_ns() - start) / 1000000.0, collection.size(),
+	     EstimateBytes(collection));
+}
+
+void OrderManager::EvictIdleCollections()
+{
+	while (orderByCollectionScene.size() > ORDER_RESIDENT_COLLECTIONS) {
+		// Least recently selected first; collections never selected (replay, import) go before any
+		auto victim = orderByCollectionScene.end();
+		uint64_t oldest = UINT64_MAX;
+		for (auto it = orderByCollectionScene.begin(); it != orderByCollectionScene.end(); ++it) {
+			if (it->first == currentCollection)
+				continue;
+			auto use = collectionUse.find(it->first);
+			uint64_t tick = use != collectionUse.end() ? use->second : 0;
+			if (tick < oldest) {
+				oldest = tick;
+				victim = it;
+			}
+		}
+		if (victim == orderByCollectionScene.end())
+			break;
+
+		// An unchanged collection is still in the store as it was read, so it is just dropped.
+		// A changed one is handed back encoded, so unsaved changes survive and still get written.
+		size_t decoded = EstimateBytes(victim->second);
+		if (changedCollections.erase(victim->first) || !store.HasCollection(victim->first)) {
+			OrderStore::Collection packed = PackCollection(victim->first);
+			size_t encoded = store.PutCollection(victim->first, packed.scenes, packed.seen, uuids.Ids());
+			blog(LOG_INFO,
+			     "[Reorderable Audio Mixer] Unloaded idle collection '%s' (~%zu bytes, %zu bytes encoded)",
+			     victim->first.c_str(), decoded, encoded);
+		} else {
+			blog(LOG_INFO,
+			     "[Reorderable Audio Mixer] Unloaded idle collection '%s' (~%zu bytes, unchanged)",
+			     victim->first.c_str(), decoded);
+		}
+		sourceSeen.erase(victim->first);
+		orderByCollectionScene.erase(victim);
+	}
+}
+
+OrderStore::Collection OrderManager::PackCollection(const std::string &name) const
+{
+	OrderStore::Collection collection;
+	collection.name = name;
+	collection.seen.collection = CollectionSeen(name);
+
+	auto collIt = orderByCollectionScene.find(name);
+	if (collIt != orderByCollectionScene.end()) {
+		for (const auto &scenePair : collIt->second) {
+			if (!scenePair.second.handles)
+				continue;
+			collection.scenes.emplace(scenePair.first, scenePair.second.handles);
+			collection.seen.scenes.emplace(scenePair.first, scenePair.second.seen);
+		}
+	}
+
+	auto seenIt = sourceSeen.find(name);
+	if (seenIt != sourceSeen.end())
+		collection.seen.ids = seenIt->second;
+	return collection;
+}
+
+uint32_t OrderManager::CollectionSeen(const std::string &name) const
+{
+	auto it = collectionSeen.find(name);
+	return it != collectionSeen.end() ? it->second : 0;
+}
+
+size_t OrderManager::EstimateBytes(const std::map<std::string, SceneOrder> &collection)
+{
+	// Map nodes carry three pointers and a colour; hash nodes a pointer plus the bucket slot
+	const size_t mapNode = 4 * sizeof(void *);
+	const size_t hashNode = 2 * sizeof(void *);
+
+	size_t bytes = 0;
+	for (const auto &scenePair : collection) {
+		const SceneOrder &order = scenePair.second;
+		bytes += mapNode + sizeof(scenePair) + scenePair.first.capacity();
+		if (order.handles)
+			bytes += sizeof(*order.handles) + order.handles->capacity() * sizeof(SourceHandle);
+		bytes += order.positions.size() * (hashNode + sizeof(std::pair<SourceHandle, size_t>));
+	}
+	return bytes;
+}
+
+OrderStore::Preferences OrderManager::GetPreferences() const
+{
+	OrderStore::Preferences preferences;
+	preferences.verticalLayout = verticalLayout;
+	preferences.virtualizedList = virtualizedList;
+	preferences.meterWall = meterWall;
+	preferences.retentionDays = retentionDays;
+	return preferences;
+}
+
+void OrderManager::ApplyPreferences(const OrderStore::Preferences &preferences)
+{
+	verticalLayout = preferences.verticalLayout;
+	virtualizedList = preferences.virtualizedList;
+	meterWall = preferences.meterWall;
+	retentionDays = preferences.retentionDays;
+}
+
+void OrderManager::SetVerticalLayout(bool vertical)
+{
+	if (verticalLayout == vertical)
+		return;
+	verticalLayout = vertical;
+	JournalPreferences();
+}
+
+void OrderManager::SetVirtualizedList(bool virtualized)
+{
+	if (virtualizedList == virtualized)
+		return;
+	virtualizedList = virtualized;
+	JournalPreferences();
+}
+
+void OrderManager::SetMeterWall(bool wall)
+{
+	if (meterWall == wall)
+		return;
+	meterWall = wall;
+	JournalPreferences();
+}
+
+void OrderManager::SetRetentionDays(uint32_t days)
+{
+	if (retentionDays == days)
+		return;
+	retentionDays = days;
+	JournalPreferences();
+}
+
+void OrderManager::Journal(OrderJournal::Op op, SourceHandle handle, uint32_t value)
+{
+	// Changes apply to the collection and scene last named in the journal
+	if (!journalContext || journalCollection != currentCollection || journalScene != currentScene) {
+		OrderJournal::AppendName(unsavedRecords, OrderJournal::Op::Collection, currentCollection);
+		OrderJournal::AppendName(unsavedRecords, OrderJournal::Op::Scene, currentScene);
+		journalCollection = currentCollection;
+		journalScene = currentScene;
+		journalContext = true;
+	}
+
+	changedCollections.insert(currentCollection);
+
+	const UuidTable::Bytes *id = handle != UuidTable::INVALID_HANDLE ? &uuids.Ids()[handle] : nullptr;
+	unsavedRecords.push_back(OrderJournal::Make(op, value, id));
+}
+
+void OrderManager::JournalPreferences()
+{
+	unsavedRecords.push_back(
+		OrderJournal::Make(OrderJournal::Op::Preferences, OrderStore::PackPreferences(GetPreferences())));
 }
 
 void OrderManager::SetCurrentScene(const std::string &sceneName)
 {
+	if (sceneName != currentScene)
+		DropCurrentIndex();
 	currentScene = sceneName;
 }
 
-std::vector<std::string> OrderManager::GetOrder() const
+std::vector<OrderManager::SourceHandle> &OrderManager::SceneOrder::Edit()
+{
+	// Only the UI thread adds owners, so a count of one can't go back up underneath us
+	if (!handles)
+		handles = std::make_shared<std::vector<SourceHandle>>();
+	else if (handles.use_count() > 1)
+		handles = std::make_shared<std::vector<SourceHandle>>(*handles);
+	return *handles;
+}
+
+void OrderManager::SceneOrder::Reindex(size_t from) const
+{
+	if (from == 0 || !indexed) {
+		from = 0;
+		positions.clear();
+		positions.reserve(Size());
+	}
+	for (size_t i = from; i < Size(); i++) {
+		positions[(*handles)[i]] = i;
+	}
+	indexed = true;
+}
+
+void OrderManager::SceneOrder::DropIndex() const
+{
+	std::unordered_map<SourceHandle, size_t>().swap(positions);
+	indexed = false;
+}
+
+void OrderManager::SceneOrder::Clear()
+{
+	handles = std::make_shared<std::vector<SourceHandle>>();
+	positions.clear();
+	indexed = true;
+}
+
+bool OrderManager::SceneOrder::Add(SourceHandle handle)
+{
+	if (!indexed)
+		Reindex();
+
+	// Don't add duplicates
+	if (!positions.emplace(handle, Size()).second)
+		return false;
+	Edit().push_back(handle);
+	return true;
+}
+
+bool OrderManager::SceneOrder::Remove(SourceHandle handle)
+{
+	if (!indexed)
+		Reindex();
+
+	auto it = positions.find(handle);
+	if (it == positions.end())
+		return false;
+
+	size_t pos = it->second;
+	positions.erase(it);
+	std::vector<SourceHandle> &list = Edit();
+	list.erase(list.begin() + pos);
+
+	// Only entries after the removed one shift
+	Reindex(pos);
+	return true;
+}
+
+bool OrderManager::SceneOrder::Move(SourceHandle handle, size_t index)
+{
+	if (index >= Size())
+		return false;
+	if (!indexed)
+		Reindex();
+
+	auto it = positions.find(handle);
+	if (it == positions.end())
+		return false;
+
+	size_t from = it->second;
+	if (from == index)
+		return false;
+
+	// Splice in place; only the entries between the two positions shift
+	std::vector<SourceHandle> &list = Edit();
+	auto begin = list.begin();
+	if (from < index)
+		std::rotate(begin + from, begin + from + 1, begin + index + 1);
+	else
+		std::rotate(begin + index, begin + from, begin + from + 1);
+
+	for (size_t i = std::min(from, index); i <= std::max(from, index); i++) {
+		positions[list[i]] = i;
+	}
+	return true;
+}
+
+size_t OrderManager::SceneOrder::RemoveAll(const std::unordered_set<SourceHandle> &dead)
+{
+	auto isDead = [&dead](SourceHandle handle) { return dead.count(handle) != 0; };
+	if (!handles || std::none_of(handles->begin(), handles->end(), isDead))
+		return 0;
+
+	std::vector<SourceHandle> &list = Edit();
+	size_t before = list.size();
+	list.erase(std::remove_if(list.begin(), list.end(), isDead), list.end());
+	if (indexed)
+		Reindex();
+	return before - list.size();
+}
+
+bool OrderManager::SceneOrder::Place(size_t slot, SourceHandle handle)
+{
+	if (slot >= Size() || (*handles)[slot] == handle)
+		return false;
+	if (!indexed)
+		Reindex();
+
+	Edit()[slot] = handle;
+	positions[handle] = slot;
+	return true;
+}
+
+const OrderManager::SceneOrder *OrderManager::FindCurrentOrder() const
 {
 	auto collIt = orderByCollectionScene.find(currentCollection);
 	if (collIt != orderByCollectionScene.end()) {
 		auto sceneIt = collIt->second.find(currentScene);
 		if (sceneIt != collIt->second.end()) {
-			return sceneIt->second;
+			const SceneOrder &order = sceneIt->second;
+			if (!order.indexed)
+				order.Reindex();
+			return &order;
 		}
 	}
-	return {};
+	return nullptr;
 }
 
-void OrderManager::SetOrder(const std::vector<std::string> &uuids)
+OrderManager::SceneOrder *OrderManager::FindCurrentOrder()
 {
-	orderByCollectionScene[currentCollection][currentScene] = uuids;
+	return const_cast<SceneOrder *>(static_cast<const OrderManager *>(this)->FindCurrentOrder());
 }
 
-void OrderManager::AddSource(const std::string &uuid)
+OrderManager::SceneOrder &OrderManager::CurrentOrder()
+{
+	SceneOrder &order = orderByCollectionScene[currentCollection][currentScene];
+	if (!order.indexed)
+		order.Reindex();
+	return order;
+}
+
+void OrderManager::DropCurrentIndex()
 {
-	auto &order = orderByCollectionScene[currentCollection][currentScene];
+	if (const SceneOrder *order = FindCurrentOrder())
+		order->DropIndex();
+}
 
-	// Don't add duplicates
-	if (std::find(order.begin(), order.end(), uuid) == order.end()) {
-		order.push_back(uuid);
+void OrderManager::SetOrder(const std::vector<std::string> &order)
+{
+	// A full reset is journaled entry by entry; compaction keeps that bounded
+	SceneOrder &current = orderByCollectionScene[currentCollection][currentScene];
+	current.Clear();
+	current.Edit().reserve(order.size());
+	Journal(OrderJournal::Op::Clear);
+
+	for (const std::string &uuid : order) {
+		SourceHandle handle = uuids.Intern(uuid);
+		if (handle != UuidTable::INVALID_HANDLE && current.Add(handle))
+			Journal(OrderJournal::Op::Add, handle);
 	}
 }
 
+void OrderManager::AddSource(const std::string &uuid)
+{
+	SourceHandle handle = uuids.Intern(uuid);
+	if (handle == UuidTable::INVALID_HANDLE)
+		return;
+
+	if (CurrentOrder().Add(handle))
+		Journal(OrderJournal::Op::Add, handle);
+}
+
 void OrderManager::RemoveSource(const std::string &uuid)
 {
+	SceneOrder *order = FindCurrentOrder();
+	if (!order)
+		return;
+
+	SourceHandle handle = uuids.Find(uuid);
+	if (order->Remove(handle))
+		Journal(OrderJournal::Op::Remove, handle);
+}
+
+int OrderManager::GetPosition(const std::string &uuid) const
+{
+	const SceneOrder *order = FindCurrentOrder();
+	if (!order)
+		return -1;
+
+	auto it = order->positions.find(uuids.Find(uuid));
+	return it != order->positions.end() ? static_cast<int>(it->second) : -1;
+}
+
+size_t OrderManager::GetOrderSize() const
+{
+	const SceneOrder *order = FindCurrentOrder();
+	return order ? order->Size() : 0;
+}
+
+bool OrderManager::MoveSource(const std::string &uuid, size_t index)
+{
+	SceneOrder *order = FindCurrentOrder();
+	if (!order || index >= order->Size())
+		return false;
+
+	SourceHandle handle = uuids.Find(uuid);
+	auto it = order->positions.find(handle);
+	if (it == order->positions.end())
+		return false;
+
+	if (order->Move(handle, index))
+		Journal(OrderJournal::Op::Move, handle, static_cast<uint32_t>(index));
+	return true;
+}
+
+bool OrderManager::ReorderSubset(const std::vector<std::string> &subset)
+{
+	SceneOrder *order = FindCurrentOrder();
+	if (!order)
+		return false;
+
+	// Reuse the slots these entries already occupy; everything else stays put
+	std::vector<SourceHandle> moved;
+	std::vector<size_t> slots;
+	moved.reserve(subset.size());
+	slots.reserve(subset.size());
+	for (const std::string &uuid : subset) {
+		SourceHandle handle = uuids.Find(uuid);
+		auto it = order->positions.find(handle);
+		if (it == order->positions.end())
+			return false;
+		moved.push_back(handle);
+		slots.push_back(it->second);
+	}
+	std::sort(slots.begin(), slots.end());
+
+	// Slots that already hold their entry are left alone, so a one-step move costs a record or two
+	for (size_t i = 0; i < moved.size(); i++) {
+		if (order->Place(slots[i], moved[i]))
+			Journal(OrderJournal::Op::Place, moved[i], static_cast<uint32_t>(slots[i]));
+	}
+	return true;
+}
+
+void OrderManager::StartReconcile(LiveState live, std::function<void()> done)
+{
+	if (!retentionDays)
+		return;
+
+	// A pass still running belongs to a collection we've since left; it stops at its next
+	// check and finishes on its own, so the UI thread never waits for it
+	auto job = std::make_unique<ReconcileJob>();
+	{
+		std::lock_guard<std::mutex> lock(reconcile->mutex);
+		job->generation = ++reconcile->generation;
+		reconcile->result.reset();
+		reconcile->running++;
+	}
+
+	// The worker only sees copies; order lists are shared snapshots, not duplicated
+	job->collection = currentCollection;
+	job->today = Today();
+	job->retentionDays = retentionDays;
+	job->live = std::move(live);
+	job->ids = uuids.Share();
+
 	auto collIt = orderByCollectionScene.find(currentCollection);
 	if (collIt != orderByCollectionScene.end()) {
-		auto sceneIt = collIt->second.find(currentScene);
-		if (sceneIt != collIt->second.end()) {
-			auto &order = sceneIt->second;
-			order.erase(std::remove(order.begin(), order.end(), uuid), order.end());
+		for (const auto &scenePair : collIt->second) {
+			if (!scenePair.second.handles)
+				continue;
+			job->scenes.emplace(scenePair.first, OrderSnapshot(scenePair.second.handles));
+			job->sceneSeen.emplace(scenePair.first, scenePair.second.seen);
 		}
 	}
+	auto seenIt = sourceSeen.find(currentCollection);
+	if (seenIt != sourceSeen.end())
+		job->sourceSeen = seenIt->second;
+	collectionSeen.emplace(currentCollection, 0);
+	job->collectionSeen = collectionSeen;
+
+	std::thread([state = reconcile, job = std::move(job), done = std::move(done)]() {
+		std::unique_ptr<ReconcileResult> result = Reconcile(*job, state->generation);
+		bool current = false;
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+			if (result && job->generation == state->generation) {
+				state->result = std::move(result);
+				current = true;
+			}
+		}
+		if (current)
+			done();
+
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->running--;
+		state->idle.notify_all();
+	}).detach();
+}
+
+std::unique_ptr<OrderManager::ReconcileResult> OrderManager::Reconcile(const ReconcileJob &job,
+									const std::atomic<uint32_t> &generation)
+{
+	auto cancelled = [&job, &generation]() {
+		return generation.load(std::memory_order_relaxed) != job.generation;
+	};
+
+	uint64_t start = os_gettime_ns();
+	auto result = std::make_unique<ReconcileResult>();
+	result->collection = job.collection;
+	result->today = job.today;
+
+	// Present entries are stamped today, missing ones without a date start their clock
+	// today, and missing ones last seen longer ago than the window are dead
+	enum class Verdict { Keep, Touch, Dead };
+	auto judge = [&job](bool present, uint32_t seen) {
+		if (present)
+			return seen == job.today ? Verdict::Keep : Verdict::Touch;
+		if (!seen)
+			return Verdict::Touch;
+		return job.today > seen && job.today - seen > job.retentionDays ? Verdict::Dead : Verdict::Keep;
+	};
+
+	std::unordered_set<std::string> liveScenes(job.live.scenes.begin(), job.live.scenes.end());
+	std::unordered_set<std::string> deadScenes;
+	for (const auto &scenePair : job.scenes) {
+		if (cancelled())
+			return nullptr;
+		auto seen = job.sceneSeen.find(scenePair.first);
+		switch (judge(liveScenes.count(scenePair.first) != 0, seen != job.sceneSeen.end() ? seen->second : 0)) {
+		case Verdict::Touch:
+			result->touchedScenes.push_back(scenePair.first);
+			break;
+		case Verdict::Dead:
+			result->deadScenes.push_back(scenePair.first);
+			result->reclaimedBytes += ORDER_SCENE_BYTES + scenePair.first.size() +
+						  scenePair.second->size() * ORDER_ENTRY_BYTES;
+			deadScenes.insert(scenePair.first);
+			break;
+		case Verdict::Keep:
+			break;
+		}
+	}
+
+	// Sources are judged by the entries left in surviving scenes
+	std::vector<UuidTable::Bytes> liveIds;
+	liveIds.reserve(job.live.sources.size());
+	for (const std::string &uuid : job.live.sources) {
+		if (cancelled())
+			return nullptr;
+		UuidTable::Bytes bytes;
+		if (UuidTable::Parse(uuid, bytes))
+			liveIds.push_back(bytes);
+	}
+	std::sort(liveIds.begin(), liveIds.end());
+
+	std::unordered_map<SourceHandle, size_t> uses;
+	for (const auto &scenePair : job.scenes) {
+		if (deadScenes.count(scenePair.first) || cancelled())
+			continue;
+		for (SourceHandle handle : *scenePair.second) {
+			uses[handle]++;
+		}
+	}
+	if (cancelled())
+		return nullptr;
+	for (const auto &use : uses) {
+		bool present = use.first < job.ids->size() &&
+			       std::binary_search(liveIds.begin(), liveIds.end(), (*job.ids)[use.first]);
+		auto seen = job.sourceSeen.find(use.first);
+		switch (judge(present, seen != job.sourceSeen.end() ? seen->second : 0)) {
+		case Verdict::Touch:
+			result->touchedSources.push_back(use.first);
+			break;
+		case Verdict::Dead:
+			// The UUID itself stays interned for the session, so only its entries count
+			result->deadSources.push_back(use.first);
+			result->reclaimedBytes += use.second * ORDER_ENTRY_BYTES;
+			break;
+		case Verdict::Keep:
+			break;
+		}
+	}
+
+	// Whole collections; their block sizes are added when they're dropped
+	std::unordered_set<std::string> liveCollections(job.live.collections.begin(), job.live.collections.end());
+	for (const auto &seenPair : job.collectionSeen) {
+		bool present = seenPair.first == job.collection || liveCollections.count(seenPair.first) != 0;
+		switch (judge(present, seenPair.second)) {
+		case Verdict::Touch:
+			result->touchedCollections.push_back(seenPair.first);
+			break;
+		case Verdict::Dead:
+			result->deadCollections.push_back(seenPair.first);
+			break;
+		case Verdict::Keep:
+			break;
+		}
+	}
+
+	result->durationNs = os_gettime_ns() - start;
+	return result;
+}
+
+bool OrderManager::FinishReconcile()
+{
+	std::unique_ptr<ReconcileResult> result;
+	{
+		std::lock_guard<std::mutex> lock(reconcile->mutex);
+		result = std::move(reconcile->result);
+	}
+	if (!result)
+		return false;
+
+	bool changed = false;
+	size_t entries = 0;
+	size_t scenesDropped = 0;
+	size_t sourcesDropped = 0;
+	size_t bytes = 0;
+
+	// Scenes and sources were judged against this collection's live state only
+	auto collIt = orderByCollectionScene.find(result->collection);
+	if (result->collection == currentCollection && collIt != orderByCollectionScene.end()) {
+		auto &scenes = collIt->second;
+		for (const std::string &name : result->touchedScenes) {
+			auto it = scenes.find(name);
+			if (it != scenes.end())
+				it->second.seen = result->today;
+		}
+		for (const std::string &name : result->deadScenes) {
+			auto it = scenes.find(name);
+			if (it == scenes.end() || name == currentScene)
+				continue;
+			entries += it->second.Size();
+			scenes.erase(it);
+			scenesDropped++;
+		}
+
+		auto &seen = sourceSeen[result->collection];
+		for (SourceHandle handle : result->touchedSources) {
+			seen[handle] = result->today;
+		}
+		if (!result->deadSources.empty()) {
+			std::unordered_set<SourceHandle> dead(result->deadSources.begin(), result->deadSources.end());
+			for (auto &scenePair : scenes) {
+				entries += scenePair.second.RemoveAll(dead);
+			}
+			for (SourceHandle handle : dead) {
+				seen.erase(handle);
+			}
+			sourcesDropped = dead.size();
+		}
+
+		bytes += result->reclaimedBytes;
+		changed = !result->touchedScenes.empty() || !result->deadScenes.empty() ||
+			  !result->touchedSources.empty() || !result->deadSources.empty();
+		if (changed)
+			changedCollections.insert(result->collection);
+	}
+
+	for (const std::string &name : result->touchedCollections) {
+		collectionSeen[name] = result->today;
+		changed = true;
+	}
+
+	size_t collectionsDropped = 0;
+	for (const std::string &name : result->deadCollections) {
+		if (name == currentCollection)
+			continue;
+
+		auto dropped = orderByCollectionScene.find(name);
+		if (dropped != orderByCollectionScene.end()) {
+			for (const auto &scenePair : dropped->second) {
+				entries += scenePair.second.Size();
+			}
+			orderByCollectionScene.erase(dropped);
+		}
+		bytes += store.RemoveCollection(name);
+		collectionSeen.erase(name);
+		collectionUse.erase(name);
+		sourceSeen.erase(name);
+		changedCollections.erase(name);
+		collectionsDropped++;
+		changed = true;
+	}
+
+	blog(LOG_INFO,
+	     "[Reorderable Audio Mixer] Order cleanup of '%s' took %.2f ms: dropped %zu entries of %zu sources, %zu scenes and %zu collections (~%zu bytes of orders)",
+	     result->collection.c_str(), double(result->durationNs) / 1000000.0, entries, sourcesDropped,
+	     scenesDropped, collectionsDropped, bytes);
+
+	// Pruning isn't journaled; the snapshot this forces is also what shrinks order.bin
+	if (changed)
+		dirty = true;
+	return changed;
 }
@@ -1,17 +1,42 @@
 #pragma once
 
+#include "order-journal.hpp"
+#include "order-store.hpp"
+#include "uuid-table.hpp"
+
 #include <string>
 #include <vector>
+#include <atomic>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 class OrderManager {
 public:
-	OrderManager();
+	using SourceHandle = UuidTable::Handle;
+
+	// Files live in the module's config directory unless another one is given
+	explicit OrderManager(std::string configDirectory = std::string());
 	~OrderManager();
 
-	// Persistence
+	// Persistence. Every change is journaled as it happens; Save() hands new journal
+	// records to a background thread that appends them at most once per debounce
+	// interval, and occasionally has it fold the journal into a new snapshot.
+	// Flush() compacts synchronously and stops the thread (used on shutdown).
 	void Load();
 	void Save();
+	void Flush();
+
+	// JSON v2 (the former order.json format) for backups and hand edits.
+	// Imported collections replace the ones in memory; others are kept.
+	bool ImportJson(const std::string &path);
+	bool ExportJson(const std::string &path);
 
 	// Current context management
 	void SetCurrentCollection(const std::string &collectionName);
@@ -20,23 +45,195 @@ public:
 	std::string GetCurrentScene() const { return currentScene; }
 
 	// Order management (operates on current collection + scene)
-	std::vector<std::string> GetOrder() const;
-	void SetOrder(const std::vector<std::string> &uuids);
+	void SetOrder(const std::vector<std::string> &order);
 	void AddSource(const std::string &uuid);
 	void RemoveSource(const std::string &uuid);
 
+	// Index lookups (operate on current collection + scene)
+	int GetPosition(const std::string &uuid) const;
+	size_t GetOrderSize() const;
+	bool MoveSource(const std::string &uuid, size_t index);
+	bool ReorderSubset(const std::vector<std::string> &subset);
+
 	// Layout preference (global, not per-scene)
 	bool IsVerticalLayout() const { return verticalLayout; }
-	void SetVerticalLayout(bool vertical) { verticalLayout = vertical; }
+	void SetVerticalLayout(bool vertical);
+	bool IsVirtualizedList() const { return virtualizedList; }
+	void SetVirtualizedList(bool virtualized);
+	bool IsMeterWall() const { return meterWall; }
+	void SetMeterWall(bool wall);
+	uint32_t GetRetentionDays() const { return retentionDays; }
+	void SetRetentionDays(uint32_t days);
+
+	// Stale-entry cleanup for the current collection. The live state is gathered on
+	// the UI thread; comparing it with the stored orders runs on a worker thread,
+	// which calls done when finished (from that thread). Starting another pass
+	// cancels one still running, whose done is then never called. FinishReconcile()
+	// applies the result on the UI thread and returns true if anything changed.
+	struct LiveState {
+		std::vector<std::string> sources;     // UUIDs of every source
+		std::vector<std::string> scenes;      // scene names in the current collection
+		std::vector<std::string> collections; // every scene collection
+	};
+	void StartReconcile(LiveState live, std::function<void()> done);
+	bool FinishReconcile();
 
 private:
-	std::string GetConfigPath() const;
-	void EnsureDirectory(const std::string &path) const;
+	// Immutable view of one scene's order. Edits made after it was taken copy
+	// the list first, so holders never see it change.
+	using OrderSnapshot = std::shared_ptr<const std::vector<SourceHandle>>;
+
+	// Ordered list of interned source handles plus a handle -> position index.
+	// The list is shared with snapshots; Edit() copies it first while shared.
+	// The index is only built for the scene in use and dropped when leaving it.
+	struct SceneOrder {
+		std::shared_ptr<std::vector<SourceHandle>> handles;
+		mutable std::unordered_map<SourceHandle, size_t> positions;
+		mutable bool indexed = false;
+		// Day the scene was last seen in OBS, 0 if not yet known
+		uint32_t seen = 0;
+
+		size_t Size() const { return handles ? handles->size() : 0; }
+		std::vector<SourceHandle> &Edit();
+		void Reindex(size_t from = 0) const;
+		void DropIndex() const;
+
+		// Edits shared by live changes and journal replay; false if nothing changed
+		void Clear();
+		bool Add(SourceHandle handle);
+		bool Remove(SourceHandle handle);
+		bool Move(SourceHandle handle, size_t index);
+		bool Place(size_t slot, SourceHandle handle);
+		size_t RemoveAll(const std::unordered_set<SourceHandle> &dead);
+	};
+
+	// Everything persisted, serialised off the UI thread. Decoded collections
+	// share their order lists; the rest refer to their block in the store.
+	struct SaveSnapshot {
+		std::string path;
+		uint32_t generation = 0;
+		OrderStore::Preferences preferences;
+		UuidTable::IdList ids;
+		std::vector<OrderStore::Collection> collections;
+	};
+
+	// Copies handed to the cleanup worker, and what it decided
+	struct ReconcileJob {
+		uint32_t generation = 0;
+		std::string collection;
+		uint32_t today = 0;
+		uint32_t retentionDays = 0;
+		LiveState live;
+		UuidTable::IdList ids;
+		std::map<std::string, OrderSnapshot> scenes;
+		std::map<std::string, uint32_t> sceneSeen;
+		std::unordered_map<SourceHandle, uint32_t> sourceSeen;
+		std::map<std::string, uint32_t> collectionSeen;
+	};
+	struct ReconcileResult {
+		std::string collection;
+		uint32_t today = 0;
+		std::vector<std::string> touchedScenes;
+		std::vector<std::string> deadScenes;
+		std::vector<SourceHandle> touchedSources;
+		std::vector<SourceHandle> deadSources;
+		std::vector<std::string> touchedCollections;
+		std::vector<std::string> deadCollections;
+		size_t reclaimedBytes = 0;
+		uint64_t durationNs = 0;
+	};
+
+	std::string GetConfigPath(const char *file) const;
+	static void EnsureDirectory(const std::string &path);
+	OrderStore::Preferences GetPreferences() const;
+	void ApplyPreferences(const OrderStore::Preferences &preferences);
+	bool ReadJson(const std::string &path, bool withPreferences);
+	bool ReplayJournal();
+	void EnsureCollectionLoaded(const std::string &name);
+	void EvictIdleCollections();
+	OrderStore::Collection PackCollection(const std::string &name) const;
+	uint32_t CollectionSeen(const std::string &name) const;
+	static std::unique_ptr<ReconcileResult> Reconcile(const ReconcileJob &job,
+							  const std::atomic<uint32_t> &generation);
+	static size_t EstimateBytes(const std::map<std::string, SceneOrder> &collection);
+	void Journal(OrderJournal::Op op, SourceHandle handle = UuidTable::INVALID_HANDLE, uint32_t value = 0);
+	void JournalPreferences();
+	std::unique_ptr<SaveSnapshot> TakeSnapshot();
+	std::unique_ptr<SaveSnapshot> BuildSnapshot();
+	void QueuePending(std::unique_ptr<SaveSnapshot> snapshot);
+	void CheckFailedSnapshot();
+	void WriteBatch(const SaveSnapshot *snapshot, const std::vector<OrderJournal::Record> &records, size_t covered);
+	static bool WriteSnapshot(const SaveSnapshot &snapshot);
+	static bool WriteJson(const SaveSnapshot &snapshot);
+	void SaverLoop();
+	const SceneOrder *FindCurrentOrder() const;
+	SceneOrder *FindCurrentOrder();
+	SceneOrder &CurrentOrder();
+	void DropCurrentIndex();
 
 private:
-	// Order storage: collection -> scene -> ordered list of source UUIDs
-	std::map<std::string, std::map<std::string, std::vector<std::string>>> orderByCollectionScene;
+	std::string configDirectory;
+
+	// Every UUID referenced by any order, stored once
+	UuidTable uuids;
+
+	// Saved orders on disk; collections are decoded into the map below when first used
+	// and handed back to it, encoded, once they haven't been selected in a while
+	OrderStore store;
+
+	// Order storage: collection -> scene -> ordered list of source handles
+	std::map<std::string, std::map<std::string, SceneOrder>> orderByCollectionScene;
+	std::map<std::string, uint64_t> collectionUse;
+	uint64_t useCounter = 0;
+	// Decoded collections that differ from their block in the store; only these are
+	// encoded again when unloaded
+	std::set<std::string> changedCollections;
+
+	// Days last seen in OBS: UUIDs per decoded collection, and every known collection
+	std::map<std::string, std::unordered_map<SourceHandle, uint32_t>> sourceSeen;
+	std::map<std::string, uint32_t> collectionSeen;
 	std::string currentCollection;
 	std::string currentScene;
 	bool verticalLayout = false;
+	bool virtualizedList = false;
+	bool meterWall = false;
+	uint32_t retentionDays = OrderStore::DEFAULT_RETENTION_DAYS;
+
+	// Journal state on the UI thread. dirty means a change that can't be journaled
+	// (load, import, cleanup), which forces a snapshot on the next save. It is set
+	// again if the saver reports that the snapshot clearing it failed to write.
+	bool dirty = false;
+	uint32_t generation = 0;
+	size_t journalRecords = 0;
+	std::vector<OrderJournal::Record> unsavedRecords;
+	std::string journalCollection;
+	std::string journalScene;
+	bool journalContext = false;
+
+	// Background saver. The journal file and its generation belong to the saver
+	// thread; pendingCovered counts the queued records the pending snapshot holds,
+	// failedGeneration is the last snapshot it couldn't write (0 if none).
+	std::string journalPath;
+	OrderJournal journal;
+	uint32_t journalGeneration = 0;
+	std::thread saverThread;
+	std::mutex saverMutex;
+	std::condition_variable saverCond;
+	std::unique_ptr<SaveSnapshot> pendingSnapshot;
+	std::vector<OrderJournal::Record> pendingRecords;
+	size_t pendingCovered = 0;
+	uint32_t failedGeneration = 0;
+	bool saverStopping = false;
+
+	// Cleanup workers run detached and share this with the manager. A pass gives up
+	// once the generation no longer matches its job's; Flush() waits for running to
+	// drop to zero.
+	struct ReconcileState {
+		std::mutex mutex;
+		std::condition_variable idle;
+		std::atomic<uint32_t> generation{0};
+		int running = 0;
+		std::unique_ptr<ReconcileResult> result;
+	};
+	std::shared_ptr<ReconcileState> reconcile = std::make_shared<ReconcileState>();
 };
@@ -0,0 +1,493 @@
+#include "order-store.hpp"
+
+#include <obs-module.h>
+#include <util/platform.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define ORDER_STORE_MAGIC "RAMORDER"
+#define ORDER_STORE_MAGIC_SIZE 8
+#define ORDER_STORE_VERSION 2
+#define ORDER_STORE_MIN_VERSION 1
+#define ORDER_STORE_HEADER_SIZE 32
+#define UUID_SIZE 16
+
+// Header flags
+#define FLAG_VERTICAL_LAYOUT (1u << 0)
+#define FLAG_VIRTUALIZED_LIST (1u << 1)
+#define FLAG_METER_WALL (1u << 2)
+
+// Retention days live in the high half of the flags: 0 means the default, all ones means never
+#define RETENTION_SHIFT 16
+#define RETENTION_NEVER 0xffffu
+
+// Read-only view of the whole file. POSIX maps it; Windows reads it into memory,
+// since a mapped file there couldn't be replaced by the next save. Blocks
+// encoded in memory use the same type so they can be written like file blocks.
+class OrderStore::MappedFile {
+public:
+	static std::shared_ptr<const MappedFile> Open(const std::string &path);
+	static std::shared_ptr<const MappedFile> FromBuffer(const std::string &bytes);
+	~MappedFile();
+
+	const uint8_t *Data() const { return data; }
+	size_t Size() const { return size; }
+
+private:
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+	bool mapped = false;
+	std::vector<uint8_t> buffer;
+};
+
+std::shared_ptr<const OrderStore::MappedFile> OrderStore::MappedFile::Open(const std::string &path)
+{
+	auto file = std::shared_ptr<MappedFile>(new MappedFile());
+
+#ifdef _WIN32
+	FILE *f = os_fopen(path.c_str(), "rb");
+	if (!f)
+		return nullptr;
+
+	int64_t length = os_fgetsize(f);
+	if (length > 0) {
+		file->buffer.resize(size_t(length));
+		if (fread(file->buffer.data(), 1, file->buffer.size(), f) != file->buffer.size())
+			file->buffer.clear();
+	}
+	fclose(f);
+
+	file->data = file->buffer.data();
+	file->size = file->buffer.size();
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		// The mapping outlives the descriptor, and the file being replaced by a later save
+		void *mapping = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping != MAP_FAILED) {
+			file->data = static_cast<const uint8_t *>(mapping);
+			file->size = size_t(st.st_size);
+			file->mapped = true;
+		}
+	}
+	close(fd);
+#endif
+
+	if (!file->size)
+		return nullptr;
+	return file;
+}
+
+std::shared_ptr<const OrderStore::MappedFile> OrderStore::MappedFile::FromBuffer(const std::string &bytes)
+{
+	auto file = std::shared_ptr<MappedFile>(new MappedFile());
+	file->buffer.assign(bytes.begin(), bytes.end());
+	file->data = file->buffer.data();
+	file->size = file->buffer.size();
+	return file;
+}
+
+OrderStore::MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+	if (mapped)
+		munmap(const_cast<uint8_t *>(data), size);
+#endif
+}
+
+namespace {
+
+// Bounds-checked cursor; any read past the end marks it failed and yields zeros
+struct Reader {
+	const uint8_t *pos;
+	const uint8_t *end;
+	bool ok = true;
+
+	Reader(const uint8_t *data, size_t size) : pos(data), end(data + size) {}
+
+	const uint8_t *Take(size_t count)
+	{
+		if (!ok || size_t(end - pos) < count) {
+			ok = false;
+			return nullptr;
+		}
+		const uint8_t *start = pos;
+		pos += count;
+		return start;
+	}
+
+	uint32_t U32()
+	{
+		uint32_t value = 0;
+		if (const uint8_t *p = Take(sizeof(value))) {
+			for (size_t i = 0; i < sizeof(value); i++)
+				value |= uint32_t(p[i]) << (8 * i);
+		}
+		return value;
+	}
+
+	uint64_t U64()
+	{
+		uint64_t value = 0;
+		if (const uint8_t *p = Take(sizeof(value))) {
+			for (size_t i = 0; i < sizeof(value); i++)
+				value |= uint64_t(p[i]) << (8 * i);
+		}
+		return value;
+	}
+
+	std::string String(size_t length)
+	{
+		const uint8_t *p = Take(length);
+		return p ? std::string(reinterpret_cast<const char *>(p), length) : std::string();
+	}
+};
+
+// Integers are written byte by byte, so the file reads the same on any host
+void PutU32(std::string &out, uint32_t value)
+{
+	for (size_t i = 0; i < sizeof(value); i++)
+		out.push_back(char(uint8_t(value >> (8 * i))));
+}
+
+void PutU64(std::string &out, uint64_t value)
+{
+	for (size_t i = 0; i < sizeof(value); i++)
+		out.push_back(char(uint8_t(value >> (8 * i))));
+}
+
+void PutString(std::string &out, const std::string &value)
+{
+	PutU32(out, uint32_t(value.size()));
+	out.append(value);
+}
+
+uint32_t SeenDay(const std::map<std::string, uint32_t> &days, const std::string &name)
+{
+	auto it = days.find(name);
+	return it != days.end() ? it->second : 0;
+}
+
+// Writes one collection block with a local UUID table holding only what its scenes use
+void EncodeCollection(std::string &out, const std::map<std::string, OrderStore::HandleList> &scenes,
+		      const OrderStore::SeenDays &seen, const std::vector<UuidTable::Bytes> &ids)
+{
+	std::unordered_map<UuidTable::Handle, uint32_t> local;
+	std::vector<UuidTable::Handle> used;
+	for (const auto &scene : scenes) {
+		for (UuidTable::Handle handle : *scene.second) {
+			if (handle < ids.size() && local.emplace(handle, uint32_t(used.size())).second)
+				used.push_back(handle);
+		}
+	}
+
+	PutU32(out, uint32_t(used.size()));
+	PutU32(out, uint32_t(scenes.size()));
+	for (UuidTable::Handle handle : used) {
+		out.append(reinterpret_cast<const char *>(ids[handle].data()), UUID_SIZE);
+	}
+	for (UuidTable::Handle handle : used) {
+		auto it = seen.ids.find(handle);
+		PutU32(out, it != seen.ids.end() ? it->second : 0);
+	}
+
+	std::string entries;
+	for (const auto &scene : scenes) {
+		PutString(out, scene.first);
+		PutU32(out, SeenDay(seen.scenes, scene.first));
+
+		entries.clear();
+		uint32_t count = 0;
+		for (UuidTable::Handle handle : *scene.second) {
+			auto it = local.find(handle);
+			if (it == local.end())
+				continue;
+			PutU32(entries, it->second);
+			count++;
+		}
+		PutU32(out, count);
+		out.append(entries);
+	}
+}
+
+} // namespace
+
+bool OrderStore::Open(const std::string &path)
+{
+	Close();
+
+	std::shared_ptr<const MappedFile> mapped = MappedFile::Open(path);
+	if (!mapped)
+		return false;
+
+	Reader header(mapped->Data(), mapped->Size());
+	const uint8_t *magic = header.Take(ORDER_STORE_MAGIC_SIZE);
+	uint32_t fileVersion = header.U32();
+	uint32_t flags = header.U32();
+	uint32_t collectionCount = header.U32();
+	uint32_t fileGeneration = header.U32();
+	uint64_t indexOffset = header.U64();
+
+	if (!header.ok || std::memcmp(magic, ORDER_STORE_MAGIC, ORDER_STORE_MAGIC_SIZE) != 0) {
+		blog(LOG_WARNING, "[Reorderable Audio Mixer] %s is not an order store", path.c_str());
+		return false;
+	}
+	if (fileVersion < ORDER_STORE_MIN_VERSION || fileVersion > ORDER_STORE_VERSION) {
+		blog(LOG_WARNING, "[Reorderable Audio Mixer] Unsupported order store version %u", fileVersion);
+		return false;
+	}
+	if (indexOffset < ORDER_STORE_HEADER_SIZE || indexOffset > mapped->Size()) {
+		blog(LOG_WARNING, "[Reorderable Audio Mixer] Order store index is out of range");
+		return false;
+	}
+
+	// Only the index is read here; collection blocks are decoded on demand
+	std::map<std::string, IndexEntry> entries;
+	Reader reader(mapped->Data() + indexOffset, mapped->Size() - indexOffset);
+	for (uint32_t i = 0; i < collectionCount && reader.ok; i++) {
+		IndexEntry entry;
+		entry.offset = reader.U64();
+		entry.size = reader.U64();
+		entry.sceneCount = reader.U32();
+		if (fileVersion >= 2)
+			entry.seen = reader.U32();
+		std::string name = reader.String(reader.U32());
+
+		if (entry.offset < ORDER_STORE_HEADER_SIZE || entry.offset > indexOffset ||
+		    entry.size > indexOffset - entry.offset)
+			reader.ok = false;
+		if (reader.ok)
+			entries[name] = entry;
+	}
+	if (!reader.ok) {
+		blog(LOG_WARNING, "[Reorderable Audio Mixer] Order store index is corrupt");
+		return false;
+	}
+
+	file = std::move(mapped);
+	index.swap(entries);
+	preferences = UnpackPreferences(flags);
+	version = fileVersion;
+	generation = fileGeneration;
+	return true;
+}
+
+void OrderStore::Close()
+{
+	file.reset();
+	index.clear();
+	preferences = Preferences();
+	version = 0;
+	generation = 0;
+}
+
+uint32_t OrderStore::CurrentVersion()
+{
+	return ORDER_STORE_VERSION;
+}
+
+uint32_t OrderStore::GetCollectionSeen(const std::string &name) const
+{
+	auto it = index.find(name);
+	return it != index.end() ? it->second.seen : 0;
+}
+
+uint32_t OrderStore::PackPreferences(const Preferences &preferences)
+{
+	uint32_t retention = preferences.retentionDays
+				     ? std::min<uint32_t>(preferences.retentionDays, RETENTION_NEVER - 1)
+				     : RETENTION_NEVER;
+	return (preferences.verticalLayout ? FLAG_VERTICAL_LAYOUT : 0) |
+	       (preferences.virtualizedList ? FLAG_VIRTUALIZED_LIST : 0) | (preferences.meterWall ? FLAG_METER_WALL : 0) |
+	       (retention << RETENTION_SHIFT);
+}
+
+OrderStore::Preferences OrderStore::UnpackPreferences(uint32_t flags)
+{
+	Preferences preferences;
+	preferences.verticalLayout = flags & FLAG_VERTICAL_LAYOUT;
+	preferences.virtualizedList = flags & FLAG_VIRTUALIZED_LIST;
+	preferences.meterWall = flags & FLAG_METER_WALL;
+
+	uint32_t retention = flags >> RETENTION_SHIFT;
+	if (retention == RETENTION_NEVER)
+		preferences.retentionDays = 0;
+	else if (retention)
+		preferences.retentionDays = retention;
+	return preferences;
+}
+
+std::vector<std::string> OrderStore::GetCollectionNames() const
+{
+	std::vector<std::string> names;
+	names.reserve(index.size());
+	for (const auto &entry : index) {
+		names.push_back(entry.first);
+	}
+	return names;
+}
+
+bool OrderStore::ReadCollection(const std::string &name, UuidTable &table, SceneHandles &scenes,
+				SeenDays &seen) const
+{
+	auto it = index.find(name);
+	if (it == index.end())
+		return false;
+
+	// Blocks put back from memory are always the current version
+	const MappedFile &source = it->second.block ? *it->second.block : *file;
+	bool hasSeen = it->second.block || version >= 2;
+	Reader reader(source.Data() + it->second.offset, size_t(it->second.size));
+	uint32_t idCount = reader.U32();
+	uint32_t sceneCount = reader.U32();
+
+	// Local ids are interned as they're read; the block refers to them by position
+	std::vector<UuidTable::Handle> handles;
+	const uint8_t *ids = reader.Take(size_t(idCount) * UUID_SIZE);
+	if (ids) {
+		handles.reserve(idCount);
+		for (uint32_t i = 0; i < idCount; i++) {
+			UuidTable::Bytes bytes;
+			std::memcpy(bytes.data(), ids + size_t(i) * UUID_SIZE, UUID_SIZE);
+			handles.push_back(table.Intern(bytes));
+		}
+	}
+
+	SeenDays days;
+	days.collection = it->second.seen;
+	if (hasSeen) {
+		for (UuidTable::Handle handle : handles) {
+			uint32_t day = reader.U32();
+			if (day)
+				days.ids[handle] = day;
+		}
+	}
+
+	SceneHandles decoded;
+	for (uint32_t i = 0; i < sceneCount && reader.ok; i++) {
+		std::string sceneName = reader.String(reader.U32());
+		if (hasSeen)
+			days.scenes[sceneName] = reader.U32();
+		uint32_t count = reader.U32();
+
+		std::vector<UuidTable::Handle> &order = decoded[sceneName];
+		if (reader.ok && size_t(reader.end - reader.pos) / sizeof(uint32_t) >= count)
+			order.reserve(count);
+		for (uint32_t j = 0; j < count && reader.ok; j++) {
+			uint32_t id = reader.U32();
+			if (id < handles.size())
+				order.push_back(handles[id]);
+		}
+	}
+
+	if (!reader.ok) {
+		blog(LOG_WARNING, "[Reorderable Audio Mixer] Order store block for collection '%s' is corrupt",
+		     name.c_str());
+		return false;
+	}
+
+	scenes.swap(decoded);
+	seen = std::move(days);
+	return true;
+}
+
+bool OrderStore::GetRawCollection(const std::string &name, Collection &collection) const
+{
+	auto it = index.find(name);
+	if (it == index.end() || (!it->second.block && version < ORDER_STORE_VERSION))
+		return false;
+
+	collection.name = name;
+	collection.file = it->second.block ? it->second.block : file;
+	collection.offset = it->second.offset;
+	collection.size = it->second.size;
+	collection.sceneCount = it->second.sceneCount;
+	collection.seen.collection = it->second.seen;
+	return true;
+}
+
+size_t OrderStore::PutCollection(const std::string &name, const std::map<std::string, HandleList> &scenes,
+				 const SeenDays &seen, const std::vector<UuidTable::Bytes> &ids)
+{
+	std::string bytes;
+	EncodeCollection(bytes, scenes, seen, ids);
+
+	IndexEntry &entry = index[name];
+	entry.block = MappedFile::FromBuffer(bytes);
+	entry.offset = 0;
+	entry.size = bytes.size();
+	entry.sceneCount = uint32_t(scenes.size());
+	entry.seen = seen.collection;
+	return bytes.size();
+}
+
+size_t OrderStore::RemoveCollection(const std::string &name)
+{
+	auto it = index.find(name);
+	if (it == index.end())
+		return 0;
+
+	size_t size = size_t(it->second.size);
+	index.erase(it);
+	return size;
+}
+
+size_t OrderStore::GetFileSize() const
+{
+	return file ? file->Size() : 0;
+}
+
+bool OrderStore::Write(const std::string &path, uint32_t generation, const Preferences &preferences,
+		       const std::vector<UuidTable::Bytes> &ids, const std::vector<Collection> &collections)
+{
+	uint32_t flags = PackPreferences(preferences);
+
+	std::string out(ORDER_STORE_HEADER_SIZE, '\0');
+	std::string indexData;
+
+	for (const Collection &collection : collections) {
+		uint64_t offset = out.size();
+		uint32_t sceneCount;
+		if (collection.file) {
+			out.append(reinterpret_cast<const char *>(collection.file->Data() + collection.offset),
+				   size_t(collection.size));
+			sceneCount = collection.sceneCount;
+		} else {
+			EncodeCollection(out, collection.scenes, collection.seen, ids);
+			sceneCount = uint32_t(collection.scenes.size());
+		}
+
+		PutU64(indexData, offset);
+		PutU64(indexData, out.size() - offset);
+		PutU32(indexData, sceneCount);
+		PutU32(indexData, collection.seen.collection);
+		PutString(indexData, collection.name);
+	}
+
+	uint64_t indexOffset = out.size();
+	out.append(indexData);
+
+	std::string header(ORDER_STORE_MAGIC, ORDER_STORE_MAGIC_SIZE);
+	PutU32(header, ORDER_STORE_VERSION);
+	PutU32(header, flags);
+	PutU32(header, uint32_t(collections.size()));
+	PutU32(header, generation);
+	PutU64(header, indexOffset);
+	out.replace(0, header.size(), header);
+
+	return os_quick_write_utf8_file_safe(path.c_str(), out.data(), out.size(), false, "tmp", "bak");
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "uuid-table.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary on-disk form of the saved orders (order.bin).
+//
+// The file is mapped (read into memory on Windows) and only its header and
+// collection index are parsed up front. Each collection is a self-contained
+// block with its own UUID table, decoded only when that collection is used,
+// and copied through verbatim when saving a collection that was never
+// decoded. Collections dropped from memory are re-encoded into blocks held
+// by the store until the next save. All integers are little-endian.
+//
+// Version 2 adds the day (since the epoch) each UUID, scene and collection
+// was last seen in OBS, 0 if not yet known, for stale-entry cleanup. Version
+// 1 files are still read, but their blocks must be decoded to be rewritten.
+//
+//   header      "RAMORDER", u32 version, u32 flags (retention days in the
+//               high 16 bits), u32 collection count, u32 generation,
+//               u64 index offset
+//   blocks      per collection: u32 id count, u32 scene count,
+//               16-byte UUIDs, u32 seen day per UUID, then per scene:
+//               u32 name length, name, u32 seen day, u32 entry count,
+//               u32 id index per entry
+//   index       per collection: u64 block offset, u64 block size,
+//               u32 scene count, u32 seen day, u32 name length, name
+class OrderStore {
+public:
+	static constexpr uint32_t DEFAULT_RETENTION_DAYS = 30;
+
+	struct Preferences {
+		bool verticalLayout = false;
+		bool virtualizedList = false;
+		bool meterWall = false;
+		// Days an entry may be missing from OBS before it's dropped; 0 keeps everything
+		uint32_t retentionDays = DEFAULT_RETENTION_DAYS;
+	};
+
+	using HandleList = std::shared_ptr<const std::vector<UuidTable::Handle>>;
+	using SceneHandles = std::map<std::string, std::vector<UuidTable::Handle>>;
+
+	// Day each part of a collection was last seen in OBS
+	struct SeenDays {
+		uint32_t collection = 0;
+		std::map<std::string, uint32_t> scenes;
+		std::unordered_map<UuidTable::Handle, uint32_t> ids;
+	};
+
+	class MappedFile;
+
+	// One collection to write: either decoded scenes, or a block of an open file
+	struct Collection {
+		std::string name;
+		std::map<std::string, HandleList> scenes;
+		SeenDays seen;
+
+		std::shared_ptr<const MappedFile> file;
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		uint32_t sceneCount = 0;
+	};
+
+	// Maps the file and reads the header and index; false if missing or invalid
+	bool Open(const std::string &path);
+	void Close();
+	bool IsOpen() const { return file != nullptr; }
+
+	const Preferences &GetPreferences() const { return preferences; }
+	// Bumped by every snapshot; pairs the file with the journal written after it
+	uint32_t GetGeneration() const { return generation; }
+	// An older file version, whose blocks can't be copied into a new file as they are
+	bool NeedsUpgrade() const { return IsOpen() && version < CurrentVersion(); }
+	uint32_t GetCollectionSeen(const std::string &name) const;
+	std::vector<std::string> GetCollectionNames() const;
+	bool HasCollection(const std::string &name) const { return index.count(name) != 0; }
+
+	// Decodes one collection, interning its UUIDs into table
+	bool ReadCollection(const std::string &name, UuidTable &table, SceneHandles &scenes, SeenDays &seen) const;
+
+	// The collection's block as it is in the open file, for writing back unchanged
+	bool GetRawCollection(const std::string &name, Collection &collection) const;
+
+	// Encodes a collection into a block of its own, replacing any block for it.
+	// Returns the block size.
+	size_t PutCollection(const std::string &name, const std::map<std::string, HandleList> &scenes,
+			     const SeenDays &seen, const std::vector<UuidTable::Bytes> &ids);
+	// Forgets a collection; it isn't written by the next save. Returns the block size.
+	size_t RemoveCollection(const std::string &name);
+
+	// Bytes of the open file, which stay mapped while the store is open
+	size_t GetFileSize() const;
+
+	// Handles in decoded collections refer to ids
+	static bool Write(const std::string &path, uint32_t generation, const Preferences &preferences,
+			  const std::vector<UuidTable::Bytes> &ids, const std::vector<Collection> &collections);
+
+	// Header flag encoding, shared with the journal
+	static uint32_t PackPreferences(const Preferences &preferences);
+	static Preferences UnpackPreferences(uint32_t flags);
+
+private:
+	static uint32_t CurrentVersion();
+
+	// Points into the open file, or into block when the collection was put back
+	struct IndexEntry {
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		uint32_t sceneCount = 0;
+		uint32_t seen = 0;
+		std::shared_ptr<const MappedFile> block;
+	};
+
+	std::shared_ptr<const MappedFile> file;
+	Preferences preferences;
+	uint32_t version = 0;
+	uint32_t generation = 0;
+	std::map<std::string, IndexEntry> index;
+};
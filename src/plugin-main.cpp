@@ -18,6 +18,9 @@ static void frontend_event_callback(obs_frontend_event event, void *)
 		return;
 
 	switch (event) {
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING:
+		QMetaObject::invokeMethod(mixer_dock, "OnSceneCollectionChanging");
+		break;
 	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
 		QMetaObject::invokeMethod(mixer_dock, "OnSceneCollectionChanged");
 		break;
@@ -0,0 +1,108 @@
+#include "uuid-table.hpp"
+
+#include <cstring>
+
+// Canonical text form: 32 hex digits in 8-4-4-4-12 groups
+#define UUID_TEXT_LENGTH 36
+
+static int HexValue(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+static bool IsDashOffset(size_t i)
+{
+	return i == 8 || i == 13 || i == 18 || i == 23;
+}
+
+bool UuidTable::Parse(std::string_view text, Bytes &bytes)
+{
+	if (text.size() != UUID_TEXT_LENGTH)
+		return false;
+
+	size_t out = 0;
+	for (size_t i = 0; i < UUID_TEXT_LENGTH; i++) {
+		if (IsDashOffset(i)) {
+			if (text[i] != '-')
+				return false;
+			continue;
+		}
+
+		int high = HexValue(text[i]);
+		int low = HexValue(text[++i]);
+		if (high < 0 || low < 0)
+			return false;
+		bytes[out++] = static_cast<uint8_t>((high << 4) | low);
+	}
+	return true;
+}
+
+std::string UuidTable::Format(const Bytes &bytes)
+{
+	static const char digits[] = "0123456789abcdef";
+
+	std::string text(UUID_TEXT_LENGTH, '-');
+	size_t in = 0;
+	for (size_t i = 0; i < UUID_TEXT_LENGTH; i++) {
+		if (IsDashOffset(i))
+			continue;
+		text[i] = digits[bytes[in] >> 4];
+		text[++i] = digits[bytes[in] & 0xf];
+		in++;
+	}
+	return text;
+}
+
+UuidTable::Handle UuidTable::Intern(std::string_view uuid)
+{
+	Bytes bytes;
+	if (!Parse(uuid, bytes))
+		return INVALID_HANDLE;
+	return Intern(bytes);
+}
+
+UuidTable::Handle UuidTable::Intern(const Bytes &bytes)
+{
+	auto it = handles.find(bytes);
+	if (it != handles.end())
+		return it->second;
+
+	// Only the owning thread adds owners, so a count of one can't go back up underneath us
+	if (ids.use_count() > 1) {
+		auto copy = std::make_shared<std::vector<Bytes>>();
+		copy->reserve(ids->size() + ids->size() / 2 + 1);
+		copy->assign(ids->begin(), ids->end());
+		ids = std::move(copy);
+	}
+
+	Handle handle = static_cast<Handle>(ids->size());
+	ids->push_back(bytes);
+	handles.emplace(bytes, handle);
+	return handle;
+}
+
+UuidTable::Handle UuidTable::Find(std::string_view uuid) const
+{
+	Bytes bytes;
+	if (!Parse(uuid, bytes))
+		return INVALID_HANDLE;
+
+	auto it = handles.find(bytes);
+	return it != handles.end() ? it->second : INVALID_HANDLE;
+}
+
+size_t UuidTable::BytesHash::operator()(const Bytes &bytes) const
+{
+	// UUIDs are random already; folding the two halves is enough
+	uint64_t a;
+	uint64_t b;
+	std::memcpy(&a, bytes.data(), sizeof(a));
+	std::memcpy(&b, bytes.data() + sizeof(a), sizeof(b));
+	return static_cast<size_t>(a ^ (b * 0x9e3779b97f4a7c15ULL));
+}
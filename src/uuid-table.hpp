@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Interned source UUIDs. Each distinct UUID is stored once as 16 raw bytes and
+// referred to everywhere else by a dense 32-bit handle. Handles stay valid for
+// the lifetime of the table. Lookups parse the textual form on the fly, so
+// they are case-insensitive and never allocate. The ID list can be shared
+// with other threads; interning copies it first while it is shared.
+class UuidTable {
+public:
+	using Handle = uint32_t;
+	using Bytes = std::array<uint8_t, 16>;
+	using IdList = std::shared_ptr<const std::vector<Bytes>>;
+
+	static constexpr Handle INVALID_HANDLE = UINT32_MAX;
+
+	// 8-4-4-4-12 hex text <-> raw bytes; Parse() rejects anything else
+	static bool Parse(std::string_view text, Bytes &bytes);
+	static std::string Format(const Bytes &bytes);
+
+	// Returns the existing handle or adds the UUID; INVALID_HANDLE if it doesn't parse
+	Handle Intern(std::string_view uuid);
+	Handle Intern(const Bytes &bytes);
+	// Lookup only; INVALID_HANDLE if unknown
+	Handle Find(std::string_view uuid) const;
+
+	std::string ToString(Handle handle) const { return Format((*ids)[handle]); }
+	size_t Size() const { return ids->size(); }
+	const std::vector<Bytes> &Ids() const { return *ids; }
+	// Immutable view indexed by handle; later interning doesn't change it
+	IdList Share() const { return ids; }
+
+private:
+	struct BytesHash {
+		size_t operator()(const Bytes &bytes) const;
+	};
+
+	std::shared_ptr<std::vector<Bytes>> ids = std::make_shared<std::vector<Bytes>>();
+	std::unordered_map<Bytes, Handle, BytesHash> handles;
+};
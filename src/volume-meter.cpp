@@ -1,13 +1,17 @@
 #include "volume-meter.hpp"
+#include "meter-ballistics.hpp"
 
 #include <util/platform.h>
 
 #include <QPainter>
 #include <QPaintEvent>
+#include <QResizeEvent>
+#include <QEvent>
 #include <QTimer>
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <utility>
 
 // Size of the input indicator in pixels
 #define INDICATOR_THICKNESS 3
@@ -15,163 +19,247 @@
 // Padding on top and bottom of vertical meters
 #define METER_PADDING 1
 
-VolumeMeter::VolumeMeter(QWidget *parent, bool vert)
+VolumeMeter::VolumeMeter(std::shared_ptr<MeterBallistics> ballistics_, QWidget *parent, bool vert)
 	: QWidget(parent),
-	  vertical(vert)
+	  vertical(vert),
+	  ballistics(std::move(ballistics_))
 {
 	setAttribute(Qt::WA_OpaquePaintEvent, true);
 
+	ballisticsSlot = ballistics->allocateSlot();
+	firstLane = size_t(ballisticsSlot) * size_t(ballistics->channelsPerSlot());
+	displayNrAudioChannels = std::min(ballistics->channelsPerSlot(), MAX_AUDIO_CHANNELS);
+
+	updateTickFont();
+	updateSizeConstraints();
+
+	resetLevels();
+
+	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+		displayedMagnitudePosition[i] = -1;
+		displayedPeakPosition[i] = -1;
+		displayedPeakHoldPosition[i] = -1;
+		displayedInputLevel[i] = -1;
+	}
+}
+
+void VolumeMeter::setVertical(bool vert)
+{
+	if (vertical == vert)
+		return;
+
+	vertical = vert;
+
+	updateSizeConstraints();
+	updateGeometry();
+	update();
+}
+
+VolumeMeter::~VolumeMeter()
+{
+	ballistics->releaseSlot(ballisticsSlot);
+}
+
+void VolumeMeter::updateTickFont()
+{
 	tickFont = font();
 	tickFont.setPointSizeF(tickFont.pointSizeF() * 0.7);
+
+	// Measured once here so painting never has to build QFontMetrics
 	QFontMetrics metrics(tickFont);
+	tickCapHeight = metrics.capHeight();
+	tickLabelWidth = metrics.boundingRect("-88").width();
+
+	scaleCacheValid = false;
+}
 
+void VolumeMeter::updateSizeConstraints()
+{
 	// Set minimum size based on orientation and channel count
 	if (vertical) {
 		// Match OBS calculation: meter width + tick marks + scale label width + spacing
 		int meterWidth = displayNrAudioChannels * (meterThickness + 1) - 1;
-		QRect scaleBounds = metrics.boundingRect("-88");
-		setMinimumSize(meterWidth + 10 + scaleBounds.width() + 2, 100);
+		setMinimumSize(meterWidth + 10 + tickLabelWidth + 2, 100);
 		setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
 	} else {
-		int minHeight = displayNrAudioChannels * (meterThickness + 1) - 1 + 4 + metrics.capHeight();
+		int minHeight = displayNrAudioChannels * (meterThickness + 1) - 1 + 4 + tickCapHeight;
 		setMinimumSize(100, minHeight);
 		setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 	}
-
-	resetLevels();
-
-	// Update timer for smooth animation (~60fps)
-	updateTimer = new QTimer(this);
-	connect(updateTimer, &QTimer::timeout, this, [this]() {
-		update();
-	});
-	updateTimer->start(16);
 }
 
-void VolumeMeter::setVertical(bool vert)
+void VolumeMeter::updateScaleCache()
 {
-	if (vertical == vert)
+	qreal dpr = devicePixelRatioF();
+	if (scaleCacheValid && scaleLayer.size() == size() * dpr && scaleVertical == vertical &&
+	    scaleLayer.devicePixelRatio() == dpr)
 		return;
 
-	vertical = vert;
+	scaleCacheValid = true;
+	scaleVertical = vertical;
 
-	// Update size policy - match OBS calculation
-	QFontMetrics metrics(tickFont);
+	if (width() <= 0 || height() <= 0) {
+		scaleLayer = QPixmap();
+		return;
+	}
+
+	// Background and tick scale in one layer, composited under the bars each frame
+	scaleLayer = QPixmap(size() * dpr);
+	scaleLayer.setDevicePixelRatio(dpr);
+	scaleLayer.fill(palette().color(QPalette::ColorRole::Window));
+
+	QPainter painter(&scaleLayer);
 	if (vertical) {
-		int meterWidth = displayNrAudioChannels * (meterThickness + 1) - 1;
-		QRect scaleBounds = metrics.boundingRect("-88");
-		setMinimumSize(meterWidth + 10 + scaleBounds.width() + 2, 100);
-		setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
+		int meterHeight = height() - METER_PADDING * 2 - (INDICATOR_THICKNESS + 3);
+		paintTicksVertical(painter, displayNrAudioChannels * (meterThickness + 1) - 1, 0, meterHeight);
 	} else {
-		int minHeight = displayNrAudioChannels * (meterThickness + 1) - 1 + 4 + metrics.capHeight();
-		setMinimumSize(100, minHeight);
-		setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+		paintTicks(painter, INDICATOR_THICKNESS + 3, displayNrAudioChannels * (meterThickness + 1) - 1,
+			   width() - (INDICATOR_THICKNESS + 3));
 	}
+}
 
-	updateGeometry();
-	update();
+void VolumeMeter::changeEvent(QEvent *event)
+{
+	switch (event->type()) {
+	case QEvent::FontChange:
+		updateTickFont();
+		updateSizeConstraints();
+		update();
+		break;
+	case QEvent::PaletteChange:
+	case QEvent::StyleChange:
+		scaleCacheValid = false;
+		update();
+		break;
+	default:
+		break;
+	}
+	QWidget::changeEvent(event);
 }
 
-VolumeMeter::~VolumeMeter()
+void VolumeMeter::setMuted(bool mute)
 {
-	updateTimer->stop();
+	if (muted == mute)
+		return;
+
+	muted = mute;
+	update();
 }
 
 void VolumeMeter::setLevels(const float magnitude[MAX_AUDIO_CHANNELS],
 			    const float peak[MAX_AUDIO_CHANNELS],
 			    const float inputPeak[MAX_AUDIO_CHANNELS])
 {
-	uint64_t ts = os_gettime_ns();
-	QMutexLocker locker(&dataMutex);
-
-	currentLastUpdateTime = ts;
-	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
-		currentMagnitude[i] = magnitude[i];
-		currentPeak[i] = peak[i];
-		currentInputPeak[i] = inputPeak[i];
-	}
+	// Called on the audio thread - must never block
+	levels.publish(os_gettime_ns(), magnitude, peak, inputPeak);
 }
 
 void VolumeMeter::resetLevels()
 {
-	currentLastUpdateTime = 0;
-	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
-		currentMagnitude[i] = -INFINITY;
-		currentPeak[i] = -INFINITY;
-		currentInputPeak[i] = -INFINITY;
-
-		displayMagnitude[i] = -INFINITY;
-		displayPeak[i] = -INFINITY;
-		displayPeakHold[i] = -INFINITY;
-		displayPeakHoldLastUpdateTime[i] = 0;
-		displayInputPeakHold[i] = -INFINITY;
-		displayInputPeakHoldLastUpdateTime[i] = 0;
-	}
+	levels.reset();
+	ballistics->resetSlot(ballisticsSlot);
 }
 
-void VolumeMeter::calculateBallisticsForChannel(int channelNr, qreal timeSinceLastRedraw)
+void VolumeMeter::clearLevels()
 {
-	uint64_t ts = os_gettime_ns();
+	resetLevels();
+	idle = true;
+	idlePainted = false;
+	updateDisplayedState();
+	update();
+}
 
-	if (currentPeak[channelNr] >= displayPeak[channelNr] ||
-	    std::isnan(displayPeak[channelNr])) {
-		// Attack of peak is immediate
-		displayPeak[channelNr] = currentPeak[channelNr];
-	} else {
-		// Decay
-		float decay = float(peakDecayRate * timeSinceLastRedraw);
-		displayPeak[channelNr] = std::clamp(
-			displayPeak[channelNr] - decay,
-			std::min(currentPeak[channelNr], 0.f), 0.f);
-	}
+void VolumeMeter::pullLevels(uint64_t ts)
+{
+	const LevelSnapshot &current = levels.acquire();
 
-	if (currentPeak[channelNr] >= displayPeakHold[channelNr] ||
-	    !std::isfinite(displayPeakHold[channelNr])) {
-		// Attack of peak-hold is immediate
-		displayPeakHold[channelNr] = currentPeak[channelNr];
-		displayPeakHoldLastUpdateTime[channelNr] = ts;
-	} else {
-		// Peak hold falls back after duration
-		qreal timeSinceLastPeak =
-			(ts - displayPeakHoldLastUpdateTime[channelNr]) * 0.000000001;
-		if (timeSinceLastPeak > peakHoldDuration) {
-			displayPeakHold[channelNr] = currentPeak[channelNr];
-			displayPeakHoldLastUpdateTime[channelNr] = ts;
+	// Check for idle (no updates for 0.5 seconds)
+	double timeSinceLastUpdate = ts > current.timestamp ? (ts - current.timestamp) * 0.000000001 : 0.0;
+	if (timeSinceLastUpdate > 0.5) {
+		// Reset lanes stay at -inf in the engine, so there is nothing to feed
+		if (!idle) {
+			resetLevels();
+			idle = true;
 		}
+		return;
 	}
 
-	if (currentInputPeak[channelNr] >= displayInputPeakHold[channelNr] ||
-	    !std::isfinite(displayInputPeakHold[channelNr])) {
-		displayInputPeakHold[channelNr] = currentInputPeak[channelNr];
-		displayInputPeakHoldLastUpdateTime[channelNr] = ts;
-	} else {
-		qreal timeSinceLastPeak =
-			(ts - displayInputPeakHoldLastUpdateTime[channelNr]) * 0.000000001;
-		if (timeSinceLastPeak > inputPeakHoldDuration) {
-			displayInputPeakHold[channelNr] = currentInputPeak[channelNr];
-			displayInputPeakHoldLastUpdateTime[channelNr] = ts;
-		}
-	}
+	idle = false;
+	idlePainted = false;
 
-	if (!std::isfinite(displayMagnitude[channelNr])) {
-		displayMagnitude[channelNr] = currentMagnitude[channelNr];
-	} else {
-		// VU meter integration
-		float attack = float((currentMagnitude[channelNr] - displayMagnitude[channelNr]) *
-				     (timeSinceLastRedraw / magnitudeIntegrationTime) * 0.99);
-		displayMagnitude[channelNr] = std::clamp(
-			displayMagnitude[channelNr] + attack,
-			(float)minimumLevel, 0.f);
+	size_t lane = firstLane;
+	for (int channelNr = 0; channelNr < displayNrAudioChannels; channelNr++, lane++) {
+		ballistics->setInput(lane, current.magnitude[channelNr], current.peak[channelNr],
+				     current.inputPeak[channelNr]);
 	}
 }
 
-void VolumeMeter::calculateBallistics(qreal timeSinceLastRedraw)
+bool VolumeMeter::refresh()
 {
-	QMutexLocker locker(&dataMutex);
+	// Already reset and painted as idle - nothing left to do
+	if (idle && idlePainted)
+		return false;
 
-	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
-		calculateBallisticsForChannel(i, timeSinceLastRedraw);
+	idlePainted = idle;
+	return updateDisplayedState();
+}
+
+int VolumeMeter::meterLength() const
+{
+	if (vertical)
+		return height() - METER_PADDING * 2 - (INDICATOR_THICKNESS + 3);
+	return width() - (INDICATOR_THICKNESS + 2);
+}
+
+int VolumeMeter::levelToPosition(float level, int length)
+{
+	// Everything below the scale draws identically, as does everything past 0 dB
+	if (!(level >= minimumLevel))
+		return -1;
+
+	qreal scale = length / minimumLevel;
+	return std::min(length - convertToInt(float(level * scale)), length + 1);
+}
+
+int VolumeMeter::inputLevelIndex(float peakHold) const
+{
+	if (peakHold < minimumInputLevel)
+		return 0;
+	else if (peakHold < warningLevel)
+		return 1;
+	else if (peakHold < errorLevel)
+		return 2;
+	else if (peakHold <= clipLevel)
+		return 3;
+	return 4;
+}
+
+bool VolumeMeter::updateDisplayedState()
+{
+	int length = meterLength();
+	bool changed = length != displayedLength;
+	displayedLength = length;
+
+	for (int channelNr = 0; channelNr < displayNrAudioChannels; channelNr++) {
+		size_t lane = firstLane + channelNr;
+		int magnitudePosition = levelToPosition(ballistics->magnitude(lane), length);
+		int peakPosition = levelToPosition(ballistics->peak(lane), length);
+		int peakHoldPosition = levelToPosition(ballistics->peakHold(lane), length);
+		int inputLevel = idle ? -1 : inputLevelIndex(ballistics->inputPeakHold(lane));
+
+		if (magnitudePosition != displayedMagnitudePosition[channelNr] ||
+		    peakPosition != displayedPeakPosition[channelNr] ||
+		    peakHoldPosition != displayedPeakHoldPosition[channelNr] ||
+		    inputLevel != displayedInputLevel[channelNr]) {
+			displayedMagnitudePosition[channelNr] = magnitudePosition;
+			displayedPeakPosition[channelNr] = peakPosition;
+			displayedPeakHoldPosition[channelNr] = peakHoldPosition;
+			displayedInputLevel[channelNr] = inputLevel;
+			changed = true;
+		}
 	}
+
+	return changed;
 }
 
 int VolumeMeter::convertToInt(float number)
@@ -187,6 +275,85 @@ int VolumeMeter::convertToInt(float number)
 		return int(number);
 }
 
+void VolumeMeter::invalidateStripCache()
+{
+	stripCacheValid = false;
+	update();
+}
+
+void VolumeMeter::renderStrip(QPixmap &strip, const QColor &nominal, const QColor &warning, const QColor &error,
+			      int length, int warningPosition, int errorPosition)
+{
+	QSize size = vertical ? QSize(meterThickness, length) : QSize(length, meterThickness);
+	qreal dpr = devicePixelRatioF();
+
+	strip = QPixmap(size * dpr);
+	strip.setDevicePixelRatio(dpr);
+
+	QPainter painter(&strip);
+	if (vertical) {
+		painter.fillRect(0, 0, meterThickness, warningPosition, nominal);
+		painter.fillRect(0, warningPosition, meterThickness, errorPosition - warningPosition, warning);
+		painter.fillRect(0, errorPosition, meterThickness, length - errorPosition, error);
+	} else {
+		painter.fillRect(0, 0, warningPosition, meterThickness, nominal);
+		painter.fillRect(warningPosition, 0, errorPosition - warningPosition, meterThickness, warning);
+		painter.fillRect(errorPosition, 0, length - errorPosition, meterThickness, error);
+	}
+}
+
+void VolumeMeter::updateStripCache(int length)
+{
+	qreal dpr = devicePixelRatioF();
+	if (stripCacheValid && stripLength == length && stripVertical == vertical && stripMuted == muted &&
+	    stripDevicePixelRatio == dpr)
+		return;
+
+	stripLength = length;
+	stripVertical = vertical;
+	stripMuted = muted;
+	stripDevicePixelRatio = dpr;
+	stripCacheValid = true;
+
+	if (length <= 0) {
+		backgroundStrip = QPixmap();
+		foregroundStrip = QPixmap();
+		return;
+	}
+
+	qreal scale = length / minimumLevel;
+	int warningPosition = length - convertToInt(warningLevel * scale);
+	int errorPosition = length - convertToInt(errorLevel * scale);
+
+	renderStrip(backgroundStrip, muted ? backgroundNominalColorDisabled : backgroundNominalColor,
+		    muted ? backgroundWarningColorDisabled : backgroundWarningColor,
+		    muted ? backgroundErrorColorDisabled : backgroundErrorColor, length, warningPosition,
+		    errorPosition);
+	renderStrip(foregroundStrip, muted ? foregroundNominalColorDisabled : foregroundNominalColor,
+		    muted ? foregroundWarningColorDisabled : foregroundWarningColor,
+		    muted ? foregroundErrorColorDisabled : foregroundErrorColor, length, warningPosition,
+		    errorPosition);
+}
+
+void VolumeMeter::blitStrip(QPainter &painter, const QPixmap &strip, const QRect &target, const QPoint &origin)
+{
+	if (strip.isNull() || target.isEmpty())
+		return;
+
+	// Source rect is in device pixels of the cached strip
+	qreal dpr = strip.devicePixelRatio();
+	QRectF source((target.x() - origin.x()) * dpr, (target.y() - origin.y()) * dpr, target.width() * dpr,
+		      target.height() * dpr);
+	painter.drawPixmap(QRectF(target), strip, source);
+}
+
+void VolumeMeter::resizeEvent(QResizeEvent *event)
+{
+	stripCacheValid = false;
+	scaleCacheValid = false;
+	QWidget::resizeEvent(event);
+}
+
 void VolumeMeter::paintInputMeter(QPainter &painter, int x, int y,
 				  int width, int height, float peakHold)
 {
@@ -210,6 +377,7 @@ void VolumeMeter::paintTicks(QPainter &painter, int x, int y, int width)
 {
 	qreal scale = width / minimumLevel;
 
+	// Only runs when the cached scale layer is rebuilt
 	painter.setFont(tickFont);
 	QFontMetrics metrics(tickFont);
 	painter.setPen(majorTickColor);
@@ -239,7 +407,6 @@ void VolumeMeter::paintMeter(QPainter &painter, int x, int y, int width, int hei
 {
 	qreal scale = width / minimumLevel;
 
-	QMutexLocker locker(&dataMutex);
 	int minimumPosition = x + 0;
 	int maximumPosition = x + width;
 	int magnitudePosition = x + width - convertToInt(magnitude * scale);
@@ -248,61 +415,26 @@ void VolumeMeter::paintMeter(QPainter &painter, int x, int y, int width, int hei
 	int warningPosition = x + width - convertToInt(warningLevel * scale);
 	int errorPosition = x + width - convertToInt(errorLevel * scale);
 
-	int nominalLength = warningPosition - minimumPosition;
-	int warningLength = errorPosition - warningPosition;
-	int errorLength = maximumPosition - errorPosition;
-	locker.unlock();
-
 	if (clipping) {
 		peakPosition = maximumPosition;
 	}
 
-	if (peakPosition < minimumPosition) {
-		// Below minimum - show all background
-		painter.fillRect(minimumPosition, y, nominalLength, height,
-				 muted ? backgroundNominalColorDisabled : backgroundNominalColor);
-		painter.fillRect(warningPosition, y, warningLength, height,
-				 muted ? backgroundWarningColorDisabled : backgroundWarningColor);
-		painter.fillRect(errorPosition, y, errorLength, height,
-				 muted ? backgroundErrorColorDisabled : backgroundErrorColor);
-	} else if (peakPosition < warningPosition) {
-		// In nominal range
-		painter.fillRect(minimumPosition, y, peakPosition - minimumPosition, height,
-				 muted ? foregroundNominalColorDisabled : foregroundNominalColor);
-		painter.fillRect(peakPosition, y, warningPosition - peakPosition, height,
-				 muted ? backgroundNominalColorDisabled : backgroundNominalColor);
-		painter.fillRect(warningPosition, y, warningLength, height,
-				 muted ? backgroundWarningColorDisabled : backgroundWarningColor);
-		painter.fillRect(errorPosition, y, errorLength, height,
-				 muted ? backgroundErrorColorDisabled : backgroundErrorColor);
-	} else if (peakPosition < errorPosition) {
-		// In warning range
-		painter.fillRect(minimumPosition, y, nominalLength, height,
-				 muted ? foregroundNominalColorDisabled : foregroundNominalColor);
-		painter.fillRect(warningPosition, y, peakPosition - warningPosition, height,
-				 muted ? foregroundWarningColorDisabled : foregroundWarningColor);
-		painter.fillRect(peakPosition, y, errorPosition - peakPosition, height,
-				 muted ? backgroundWarningColorDisabled : backgroundWarningColor);
-		painter.fillRect(errorPosition, y, errorLength, height,
-				 muted ? backgroundErrorColorDisabled : backgroundErrorColor);
-	} else if (peakPosition < maximumPosition) {
-		// In error range
-		painter.fillRect(minimumPosition, y, nominalLength, height,
-				 muted ? foregroundNominalColorDisabled : foregroundNominalColor);
-		painter.fillRect(warningPosition, y, warningLength, height,
-				 muted ? foregroundWarningColorDisabled : foregroundWarningColor);
-		painter.fillRect(errorPosition, y, peakPosition - errorPosition, height,
-				 muted ? foregroundErrorColorDisabled : foregroundErrorColor);
-		painter.fillRect(peakPosition, y, maximumPosition - peakPosition, height,
-				 muted ? backgroundErrorColorDisabled : backgroundErrorColor);
+	if (peakPosition < maximumPosition) {
+		// Lit part from the foreground strip, the rest from the background strip
+		int split = std::clamp(peakPosition, minimumPosition, maximumPosition);
+		QPoint origin(x, y);
+		blitStrip(painter, foregroundStrip, QRect(minimumPosition, y, split - minimumPosition, height), origin);
+		blitStrip(painter, backgroundStrip, QRect(split, y, maximumPosition - split, height), origin);
 	} else {
 		// Clipping
 		if (!clipping) {
 			clipping = true;
-			QTimer::singleShot(1000, this, [this]() { clipping = false; });
+			QTimer::singleShot(1000, this, [this]() {
+				clipping = false;
+				update();
+			});
 		}
-		int end = errorLength + warningLength + nominalLength;
-		painter.fillRect(minimumPosition, y, end, height,
+		painter.fillRect(minimumPosition, y, width, height,
 				 muted ? foregroundErrorColorDisabled : foregroundErrorColor);
 	}
 
@@ -377,7 +509,6 @@ void VolumeMeter::paintMeterVertical(QPainter &painter, int x, int y, int width,
 	// but with Y axis inverted by painter transform in paintEvent
 	qreal scale = height / minimumLevel;
 
-	QMutexLocker locker(&dataMutex);
 	int minimumPosition = y + 0;
 	int maximumPosition = y + height;
 	int magnitudePosition = y + height - convertToInt(magnitude * scale);
@@ -386,56 +517,24 @@ void VolumeMeter::paintMeterVertical(QPainter &painter, int x, int y, int width,
 	int warningPosition = y + height - convertToInt(warningLevel * scale);
 	int errorPosition = y + height - convertToInt(errorLevel * scale);
 
-	int nominalLength = warningPosition - minimumPosition;
-	int warningLength = errorPosition - warningPosition;
-	int errorLength = maximumPosition - errorPosition;
-	locker.unlock();
-
 	if (clipping) {
 		peakPosition = maximumPosition;
 	}
 
-	if (peakPosition < minimumPosition) {
-		painter.fillRect(x, minimumPosition, width, nominalLength,
-				 muted ? backgroundNominalColorDisabled : backgroundNominalColor);
-		painter.fillRect(x, warningPosition, width, warningLength,
-				 muted ? backgroundWarningColorDisabled : backgroundWarningColor);
-		painter.fillRect(x, errorPosition, width, errorLength,
-				 muted ? backgroundErrorColorDisabled : backgroundErrorColor);
-	} else if (peakPosition < warningPosition) {
-		painter.fillRect(x, minimumPosition, width, peakPosition - minimumPosition,
-				 muted ? foregroundNominalColorDisabled : foregroundNominalColor);
-		painter.fillRect(x, peakPosition, width, warningPosition - peakPosition,
-				 muted ? backgroundNominalColorDisabled : backgroundNominalColor);
-		painter.fillRect(x, warningPosition, width, warningLength,
-				 muted ? backgroundWarningColorDisabled : backgroundWarningColor);
-		painter.fillRect(x, errorPosition, width, errorLength,
-				 muted ? backgroundErrorColorDisabled : backgroundErrorColor);
-	} else if (peakPosition < errorPosition) {
-		painter.fillRect(x, minimumPosition, width, nominalLength,
-				 muted ? foregroundNominalColorDisabled : foregroundNominalColor);
-		painter.fillRect(x, warningPosition, width, peakPosition - warningPosition,
-				 muted ? foregroundWarningColorDisabled : foregroundWarningColor);
-		painter.fillRect(x, peakPosition, width, errorPosition - peakPosition,
-				 muted ? backgroundWarningColorDisabled : backgroundWarningColor);
-		painter.fillRect(x, errorPosition, width, errorLength,
-				 muted ? backgroundErrorColorDisabled : backgroundErrorColor);
-	} else if (peakPosition < maximumPosition) {
-		painter.fillRect(x, minimumPosition, width, nominalLength,
-				 muted ? foregroundNominalColorDisabled : foregroundNominalColor);
-		painter.fillRect(x, warningPosition, width, warningLength,
-				 muted ? foregroundWarningColorDisabled : foregroundWarningColor);
-		painter.fillRect(x, errorPosition, width, peakPosition - errorPosition,
-				 muted ? foregroundErrorColorDisabled : foregroundErrorColor);
-		painter.fillRect(x, peakPosition, width, maximumPosition - peakPosition,
-				 muted ? backgroundErrorColorDisabled : backgroundErrorColor);
+	if (peakPosition < maximumPosition) {
+		int split = std::clamp(peakPosition, minimumPosition, maximumPosition);
+		QPoint origin(x, y);
+		blitStrip(painter, foregroundStrip, QRect(x, minimumPosition, width, split - minimumPosition), origin);
+		blitStrip(painter, backgroundStrip, QRect(x, split, width, maximumPosition - split), origin);
 	} else {
 		if (!clipping) {
 			clipping = true;
-			QTimer::singleShot(1000, this, [this]() { clipping = false; });
+			QTimer::singleShot(1000, this, [this]() {
+				clipping = false;
+				update();
+			});
 		}
-		int end = errorLength + warningLength + nominalLength;
-		painter.fillRect(x, minimumPosition, width, end,
+		painter.fillRect(x, minimumPosition, width, height,
 				 muted ? foregroundErrorColorDisabled : foregroundErrorColor);
 	}
 
@@ -459,35 +558,19 @@ void VolumeMeter::paintMeterVertical(QPainter &painter, int x, int y, int width,
 
 void VolumeMeter::paintEvent(QPaintEvent *event)
 {
-	uint64_t ts = os_gettime_ns();
-	qreal timeSinceLastRedraw = (ts - lastRedrawTime) * 0.000000001;
-
-	// Check for idle (no updates for 0.5 seconds)
-	bool idle = false;
-	{
-		QMutexLocker locker(&dataMutex);
-		double timeSinceLastUpdate = (ts - currentLastUpdateTime) * 0.000000001;
-		if (timeSinceLastUpdate > 0.5) {
-			resetLevels();
-			idle = true;
-		}
-	}
-
-	if (!idle) {
-		calculateBallistics(timeSinceLastRedraw);
-	}
-
+	// Ballistics are advanced by refresh(); painting only draws the current state
 	QRect widgetRect = rect();
 	int width = widgetRect.width();
 	int height = widgetRect.height();
 
 	QPainter painter(this);
 
-	// Paint background
-	QColor background = palette().color(QPalette::ColorRole::Window);
-	painter.fillRect(event->region().boundingRect(), background);
-
-	QFontMetrics metrics(tickFont);
+	// Background and tick scale come from the cached layer
+	updateScaleCache();
+	if (!scaleLayer.isNull())
+		painter.drawPixmap(0, 0, scaleLayer);
+	else
+		painter.fillRect(event->region().boundingRect(), palette().color(QPalette::ColorRole::Window));
 
 	if (vertical) {
 		// Vertical mode - match OBS stock meter layout exactly
@@ -495,11 +578,7 @@ void VolumeMeter::paintEvent(QPaintEvent *event)
 		height -= METER_PADDING * 2;
 		int meterHeight = height - (INDICATOR_THICKNESS + 3);
 
-		// Draw tick marks BEFORE coordinate transform (normal Y axis)
-		paintTicksVertical(painter,
-				   displayNrAudioChannels * (meterThickness + 1) - 1,
-				   0,
-				   meterHeight);
+		updateStripCache(meterHeight);
 
 		// Invert the Y axis to ease the meter math (0 at bottom, increases upward)
 		painter.translate(0, height + METER_PADDING);
@@ -513,9 +592,9 @@ void VolumeMeter::paintEvent(QPaintEvent *event)
 					   INDICATOR_THICKNESS + 2,
 					   meterThickness,
 					   meterHeight,
-					   displayMagnitude[channelNr],
-					   displayPeak[channelNr],
-					   displayPeakHold[channelNr]);
+					   ballistics->magnitude(firstLane + channelNr),
+					   ballistics->peak(firstLane + channelNr),
+					   ballistics->peakHold(firstLane + channelNr));
 
 			// Input indicator at bottom (which appears at top after Y inversion)
 			if (!idle) {
@@ -524,18 +603,12 @@ void VolumeMeter::paintEvent(QPaintEvent *event)
 							0,
 							meterThickness,
 							INDICATOR_THICKNESS,
-							displayInputPeakHold[channelNr]);
+							ballistics->inputPeakHold(firstLane + channelNr));
 			}
 		}
 	} else {
 		// Horizontal mode - meters go left to right, channels stacked
-		int tickHeight = 4 + metrics.capHeight();
-		int meterHeight = height - tickHeight;
-
-		// Draw tick marks and labels
-		paintTicks(painter, INDICATOR_THICKNESS + 3,
-			   displayNrAudioChannels * (meterThickness + 1) - 1,
-			   width - (INDICATOR_THICKNESS + 3));
+		updateStripCache(width - (INDICATOR_THICKNESS + 2));
 
 		// Draw meters for each channel
 		for (int channelNr = 0; channelNr < displayNrAudioChannels; channelNr++) {
@@ -544,9 +617,9 @@ void VolumeMeter::paintEvent(QPaintEvent *event)
 				   channelNr * (meterThickness + 1),
 				   width - (INDICATOR_THICKNESS + 2),
 				   meterThickness,
-				   displayMagnitude[channelNr],
-				   displayPeak[channelNr],
-				   displayPeakHold[channelNr]);
+				   ballistics->magnitude(firstLane + channelNr),
+				   ballistics->peak(firstLane + channelNr),
+				   ballistics->peakHold(firstLane + channelNr));
 
 			if (!idle) {
 				paintInputMeter(painter,
@@ -554,10 +627,8 @@ void VolumeMeter::paintEvent(QPaintEvent *event)
 						channelNr * (meterThickness + 1),
 						INDICATOR_THICKNESS,
 						meterThickness,
-						displayInputPeakHold[channelNr]);
+						ballistics->inputPeakHold(firstLane + channelNr));
 			}
 		}
 	}
-
-	lastRedrawTime = ts;
 }
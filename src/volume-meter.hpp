@@ -1,11 +1,16 @@
 #pragma once
 
+#include "level-handoff.hpp"
+
 #include <obs.h>
 
 #include <QWidget>
-#include <QMutex>
-#include <QTimer>
 #include <QFont>
+#include <QPixmap>
+
+#include <memory>
+
+class MeterBallistics;
 
 class VolumeMeter : public QWidget {
 	Q_OBJECT
@@ -30,45 +35,85 @@ class VolumeMeter : public QWidget {
 		WRITE setMinorTickColor DESIGNABLE true)
 
 public:
-	explicit VolumeMeter(QWidget *parent = nullptr, bool vertical = false);
+	explicit VolumeMeter(std::shared_ptr<MeterBallistics> ballistics, QWidget *parent = nullptr,
+			     bool vertical = false);
 	~VolumeMeter();
 
 	void setLevels(const float magnitude[MAX_AUDIO_CHANNELS],
 		       const float peak[MAX_AUDIO_CHANNELS],
 		       const float inputPeak[MAX_AUDIO_CHANNELS]);
 
+	// Driven once per frame by the dock's shared refresh clock: pullLevels()
+	// feeds the latest levels into the shared ballistics engine, and after the
+	// engine has run refresh() returns true if the meter needs a repaint.
+	void pullLevels(uint64_t ts);
+	bool refresh();
+
+	// Drop all displayed levels, e.g. while metering is suspended
+	void clearLevels();
+
 	void setVertical(bool vert);
 	bool isVertical() const { return vertical; }
 
-	bool muted = false;
+	void setMuted(bool mute);
+	bool isMuted() const { return muted; }
 
 	// Property getters/setters for theme support
 	QColor getBackgroundNominalColor() const { return backgroundNominalColor; }
-	void setBackgroundNominalColor(QColor c) { backgroundNominalColor = c; }
+	void setBackgroundNominalColor(QColor c)
+	{
+		backgroundNominalColor = c;
+		invalidateStripCache();
+	}
 	QColor getBackgroundWarningColor() const { return backgroundWarningColor; }
-	void setBackgroundWarningColor(QColor c) { backgroundWarningColor = c; }
+	void setBackgroundWarningColor(QColor c)
+	{
+		backgroundWarningColor = c;
+		invalidateStripCache();
+	}
 	QColor getBackgroundErrorColor() const { return backgroundErrorColor; }
-	void setBackgroundErrorColor(QColor c) { backgroundErrorColor = c; }
+	void setBackgroundErrorColor(QColor c)
+	{
+		backgroundErrorColor = c;
+		invalidateStripCache();
+	}
 	QColor getForegroundNominalColor() const { return foregroundNominalColor; }
-	void setForegroundNominalColor(QColor c) { foregroundNominalColor = c; }
+	void setForegroundNominalColor(QColor c)
+	{
+		foregroundNominalColor = c;
+		invalidateStripCache();
+	}
 	QColor getForegroundWarningColor() const { return foregroundWarningColor; }
-	void setForegroundWarningColor(QColor c) { foregroundWarningColor = c; }
+	void setForegroundWarningColor(QColor c)
+	{
+		foregroundWarningColor = c;
+		invalidateStripCache();
+	}
 	QColor getForegroundErrorColor() const { return foregroundErrorColor; }
-	void setForegroundErrorColor(QColor c) { foregroundErrorColor = c; }
+	void setForegroundErrorColor(QColor c)
+	{
+		foregroundErrorColor = c;
+		invalidateStripCache();
+	}
 	QColor getMagnitudeColor() const { return magnitudeColor; }
 	void setMagnitudeColor(QColor c) { magnitudeColor = c; }
 	QColor getMajorTickColor() const { return majorTickColor; }
-	void setMajorTickColor(QColor c) { majorTickColor = c; }
+	void setMajorTickColor(QColor c)
+	{
+		majorTickColor = c;
+		scaleCacheValid = false;
+		update();
+	}
 	QColor getMinorTickColor() const { return minorTickColor; }
 	void setMinorTickColor(QColor c) { minorTickColor = c; }
 
 protected:
 	void paintEvent(QPaintEvent *event) override;
+	void resizeEvent(QResizeEvent *event) override;
+	void changeEvent(QEvent *event) override;
 
 private:
 	void resetLevels();
-	void calculateBallistics(qreal timeSinceLastRedraw);
-	void calculateBallisticsForChannel(int channelNr, qreal timeSinceLastRedraw);
 	void paintMeter(QPainter &painter, int x, int y, int width, int height,
 			float magnitude, float peak, float peakHold);
 	void paintMeterVertical(QPainter &painter, int x, int y, int width, int height,
@@ -80,25 +125,40 @@ private:
 	void paintInputMeterVertical(QPainter &painter, int x, int y, int width, int height,
 				     float peakHold);
 	int convertToInt(float number);
+	void updateTickFont();
+	void updateSizeConstraints();
+	void updateScaleCache();
+	void invalidateStripCache();
+	void updateStripCache(int length);
+	void renderStrip(QPixmap &strip, const QColor &nominal, const QColor &warning, const QColor &error,
+			 int length, int warningPosition, int errorPosition);
+	void blitStrip(QPainter &painter, const QPixmap &strip, const QRect &target, const QPoint &origin);
+	int meterLength() const;
+	int levelToPosition(float level, int length);
+	int inputLevelIndex(float peakHold) const;
+	bool updateDisplayedState();
 
 	bool vertical = false;
+	bool muted = false;
 
-	QMutex dataMutex;
+	// Written by the audio thread, read by the UI thread without locking
+	LevelHandoff levels;
 
-	uint64_t currentLastUpdateTime = 0;
-	float currentMagnitude[MAX_AUDIO_CHANNELS];
-	float currentPeak[MAX_AUDIO_CHANNELS];
-	float currentInputPeak[MAX_AUDIO_CHANNELS];
+	// Display state lives in the dock-wide engine, one lane per channel
+	std::shared_ptr<MeterBallistics> ballistics;
+	int ballisticsSlot = -1;
+	size_t firstLane = 0;
 
 	int displayNrAudioChannels = 2;
-	float displayMagnitude[MAX_AUDIO_CHANNELS];
-	float displayPeak[MAX_AUDIO_CHANNELS];
-	float displayPeakHold[MAX_AUDIO_CHANNELS];
-	uint64_t displayPeakHoldLastUpdateTime[MAX_AUDIO_CHANNELS];
-	float displayInputPeakHold[MAX_AUDIO_CHANNELS];
-	uint64_t displayInputPeakHoldLastUpdateTime[MAX_AUDIO_CHANNELS];
 
 	QFont tickFont;
+	int tickCapHeight = 0;
+	int tickLabelWidth = 0;
+
+	// Window background plus tick scale, rebuilt on resize, font or palette change
+	QPixmap scaleLayer;
+	bool scaleCacheValid = false;
+	bool scaleVertical = false;
 
 	// Colors
 	QColor backgroundNominalColor{0x26, 0x7f, 0x26};  // Dark green
@@ -120,6 +180,16 @@ private:
 	QColor foregroundWarningColorDisabled{150, 150, 150};
 	QColor foregroundErrorColorDisabled{150, 150, 150};
 
+	// Pre-rendered nominal/warning/error strips for one channel, rebuilt only
+	// when length, orientation, mute state, DPR or theme colours change
+	QPixmap backgroundStrip;
+	QPixmap foregroundStrip;
+	bool stripCacheValid = false;
+	int stripLength = 0;
+	bool stripVertical = false;
+	bool stripMuted = false;
+	qreal stripDevicePixelRatio = 1.0;
+
 	// Meter settings
 	int meterThickness = 7;
 	qreal minimumLevel = -60.0;
@@ -127,13 +197,15 @@ private:
 	qreal errorLevel = -9.0;
 	qreal clipLevel = -0.5;
 	qreal minimumInputLevel = -50.0;
-	qreal peakDecayRate = 11.76;          // 20 dB / 1.7 sec
-	qreal magnitudeIntegrationTime = 0.3; // 99% in 300 ms
-	qreal peakHoldDuration = 20.0;        // 20 seconds
-	qreal inputPeakHoldDuration = 1.0;    // 1 second
 
-	uint64_t lastRedrawTime = 0;
+	bool idle = false;
+	bool idlePainted = false;
 	bool clipping = false;
 
-	QTimer *updateTimer = nullptr;
+	// Last state handed to paintEvent, in pixels, used to skip no-op repaints
+	int displayedLength = -1;
+	int displayedMagnitudePosition[MAX_AUDIO_CHANNELS];
+	int displayedPeakPosition[MAX_AUDIO_CHANNELS];
+	int displayedPeakHoldPosition[MAX_AUDIO_CHANNELS];
+	int displayedInputLevel[MAX_AUDIO_CHANNELS];
 };
@@ -0,0 +1,253 @@
+#include "meter-ballistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Checks MeterBallistics against the per-channel ballistics VolumeMeter used before they were
+// batched. Each build of this file exercises one kernel (AVX, SSE2, NEON or scalar), chosen by
+// the compile options of its test target. MAX_AUDIO_CHANNELS comes from the build as well, so
+// the test needs nothing from libobs.
+
+// Largest difference in dB accepted between the kernel and the reference
+#define TOLERANCE 1e-3f
+
+// Frames run for every channel count
+#define FRAME_COUNT 6000
+
+// Meters sharing the engine, so lanes of different slots sit in the same vector
+#define METER_COUNT 3
+
+// Exit code for a kernel the host cannot run; ctest reports it as skipped
+#define SKIP_RETURN_CODE 77
+
+namespace {
+
+// VolumeMeter::calculateBallisticsForChannel() as it was, for a single meter. The wall clock
+// read through os_gettime_ns() is replaced by the simulated time of the test.
+struct ReferenceMeter {
+	double minimumLevel = -60.0;
+	double peakDecayRate = 11.76;          // 20 dB / 1.7 sec
+	double magnitudeIntegrationTime = 0.3; // 99% in 300 ms
+	double peakHoldDuration = 20.0;        // 20 seconds
+	double inputPeakHoldDuration = 1.0;    // 1 second
+
+	float currentMagnitude[MAX_AUDIO_CHANNELS];
+	float currentPeak[MAX_AUDIO_CHANNELS];
+	float currentInputPeak[MAX_AUDIO_CHANNELS];
+
+	float displayMagnitude[MAX_AUDIO_CHANNELS];
+	float displayPeak[MAX_AUDIO_CHANNELS];
+	float displayPeakHold[MAX_AUDIO_CHANNELS];
+	double displayPeakHoldLastUpdateTime[MAX_AUDIO_CHANNELS];
+	float displayInputPeakHold[MAX_AUDIO_CHANNELS];
+	double displayInputPeakHoldLastUpdateTime[MAX_AUDIO_CHANNELS];
+
+	ReferenceMeter() { resetLevels(); }
+
+	void resetLevels()
+	{
+		for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+			currentMagnitude[i] = -INFINITY;
+			currentPeak[i] = -INFINITY;
+			currentInputPeak[i] = -INFINITY;
+
+			displayMagnitude[i] = -INFINITY;
+			displayPeak[i] = -INFINITY;
+			displayPeakHold[i] = -INFINITY;
+			displayPeakHoldLastUpdateTime[i] = 0;
+			displayInputPeakHold[i] = -INFINITY;
+			displayInputPeakHoldLastUpdateTime[i] = 0;
+		}
+	}
+
+	void calculateBallisticsForChannel(int channelNr, double timeSinceLastRedraw, double ts)
+	{
+		if (currentPeak[channelNr] >= displayPeak[channelNr] || std::isnan(displayPeak[channelNr])) {
+			// Attack of peak is immediate
+			displayPeak[channelNr] = currentPeak[channelNr];
+		} else {
+			// Decay
+			float decay = float(peakDecayRate * timeSinceLastRedraw);
+			displayPeak[channelNr] = std::clamp(displayPeak[channelNr] - decay,
+							    std::min(currentPeak[channelNr], 0.f), 0.f);
+		}
+
+		if (currentPeak[channelNr] >= displayPeakHold[channelNr] ||
+		    !std::isfinite(displayPeakHold[channelNr])) {
+			// Attack of peak-hold is immediate
+			displayPeakHold[channelNr] = currentPeak[channelNr];
+			displayPeakHoldLastUpdateTime[channelNr] = ts;
+		} else {
+			// Peak hold falls back after duration
+			double timeSinceLastPeak = ts - displayPeakHoldLastUpdateTime[channelNr];
+			if (timeSinceLastPeak > peakHoldDuration) {
+				displayPeakHold[channelNr] = currentPeak[channelNr];
+				displayPeakHoldLastUpdateTime[channelNr] = ts;
+			}
+		}
+
+		if (currentInputPeak[channelNr] >= displayInputPeakHold[channelNr] ||
+		    !std::isfinite(displayInputPeakHold[channelNr])) {
+			displayInputPeakHold[channelNr] = currentInputPeak[channelNr];
+			displayInputPeakHoldLastUpdateTime[channelNr] = ts;
+		} else {
+			double timeSinceLastPeak = ts - displayInputPeakHoldLastUpdateTime[channelNr];
+			if (timeSinceLastPeak > inputPeakHoldDuration) {
+				displayInputPeakHold[channelNr] = currentInputPeak[channelNr];
+				displayInputPeakHoldLastUpdateTime[channelNr] = ts;
+			}
+		}
+
+		if (!std::isfinite(displayMagnitude[channelNr])) {
+			displayMagnitude[channelNr] = currentMagnitude[channelNr];
+		} else {
+			// VU meter integration
+			float attack = float((currentMagnitude[channelNr] - displayMagnitude[channelNr]) *
+					     (timeSinceLastRedraw / magnitudeIntegrationTime) * 0.99);
+			displayMagnitude[channelNr] =
+				std::clamp(displayMagnitude[channelNr] + attack, (float)minimumLevel, 0.f);
+		}
+	}
+};
+
+// Levels wander like program audio: mostly held or falling, with jumps, clipping and silence
+struct LevelSource {
+	float level = -INFINITY;
+
+	float next(std::mt19937 &rng)
+	{
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		float roll = unit(rng);
+		if (roll < 0.05f)
+			level = -INFINITY;
+		else if (roll < 0.15f || !std::isfinite(level))
+			level = -70.0f + unit(rng) * 73.0f;
+		else if (roll < 0.6f)
+			level -= unit(rng) * 2.0f;
+		return level;
+	}
+};
+
+bool matches(float actual, float expected)
+{
+	if (std::isinf(expected) || std::isinf(actual))
+		return actual == expected;
+	return std::fabs(actual - expected) <= TOLERANCE;
+}
+
+bool check(const char *what, int channels, int frame, int meter, int channel, float actual, float expected)
+{
+	if (matches(actual, expected))
+		return true;
+
+	fprintf(stderr, "%s mismatch: %d channels, frame %d, meter %d, channel %d: got %f, expected %f\n", what,
+		channels, frame, meter, channel, actual, expected);
+	return false;
+}
+
+bool runChannelCount(int channels, std::mt19937 &rng)
+{
+	MeterBallistics ballistics(channels);
+	ReferenceMeter reference[METER_COUNT];
+	LevelSource magnitudes[METER_COUNT][MAX_AUDIO_CHANNELS];
+	LevelSource peaks[METER_COUNT][MAX_AUDIO_CHANNELS];
+	int slots[METER_COUNT];
+	for (int meter = 0; meter < METER_COUNT; meter++)
+		slots[meter] = ballistics.allocateSlot();
+
+	std::uniform_int_distribution<int> shortStep(4, 80); // ~4 to ~78 ms
+	std::uniform_int_distribution<int> longStep(512, 2048); // 0.5 to 2 s
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::uniform_real_distribution<float> headroom(0.0f, 6.0f);
+
+	double now = 0.0;
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		// Steps are multiples of 1/1024 s, so the hold ages summed in float by the kernel and the
+		// timestamps subtracted in double by the reference stay exact around the hold durations
+		int ticks = unit(rng) < 0.01f ? longStep(rng) : shortStep(rng);
+		double dt = ticks / 1024.0;
+		now += dt;
+
+		for (int meter = 0; meter < METER_COUNT; meter++) {
+			ReferenceMeter &ref = reference[meter];
+
+			// Metering stops and resumes now and then, as idle meters do
+			if (unit(rng) < 0.002f) {
+				ballistics.resetSlot(slots[meter]);
+				ref.resetLevels();
+			}
+
+			for (int channel = 0; channel < channels; channel++) {
+				float peak = peaks[meter][channel].next(rng);
+				float magnitude = std::isfinite(peak) ? std::max(magnitudes[meter][channel].next(rng), peak - 20.0f)
+								      : -INFINITY;
+				magnitude = std::min(magnitude, peak);
+				float inputPeak = std::isfinite(peak) ? peak + headroom(rng) : peak;
+
+				ref.currentMagnitude[channel] = magnitude;
+				ref.currentPeak[channel] = peak;
+				ref.currentInputPeak[channel] = inputPeak;
+				ballistics.setInput(size_t(slots[meter]) * size_t(channels) + size_t(channel), magnitude,
+						    peak, inputPeak);
+			}
+		}
+
+		ballistics.process(float(dt));
+
+		for (int meter = 0; meter < METER_COUNT; meter++) {
+			ReferenceMeter &ref = reference[meter];
+			for (int channel = 0; channel < channels; channel++) {
+				ref.calculateBallisticsForChannel(channel, dt, now);
+
+				size_t lane = size_t(slots[meter]) * size_t(channels) + size_t(channel);
+				if (!check("Peak", channels, frame, meter, channel, ballistics.peak(lane),
+					   ref.displayPeak[channel]) ||
+				    !check("Peak hold", channels, frame, meter, channel, ballistics.peakHold(lane),
+					   ref.displayPeakHold[channel]) ||
+				    !check("Input peak hold", channels, frame, meter, channel,
+					   ballistics.inputPeakHold(lane), ref.displayInputPeakHold[channel]) ||
+				    !check("Magnitude", channels, frame, meter, channel, ballistics.magnitude(lane),
+					   ref.displayMagnitude[channel]))
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool hostSupportsKernel()
+{
+#if defined(__AVX__) && !defined(BALLISTICS_FORCE_SCALAR) && (defined(__GNUC__) || defined(__clang__))
+	return __builtin_cpu_supports("avx");
+#else
+	return true;
+#endif
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	if (!hostSupportsKernel()) {
+		printf("Skipped: the host does not support this kernel\n");
+		return SKIP_RETURN_CODE;
+	}
+
+	unsigned seed = argc > 1 ? unsigned(strtoul(argv[1], nullptr, 10)) : 20240611u;
+	std::mt19937 rng(seed);
+
+	// Up to a full 7.1 slot, which is exactly one AVX vector
+	for (int channels = 1; channels <= MAX_AUDIO_CHANNELS; channels++) {
+		if (!runChannelCount(channels, rng)) {
+			fprintf(stderr, "Failed with seed %u\n", seed);
+			return EXIT_FAILURE;
+		}
+	}
+
+	printf("Ballistics match the reference for 1 to %d channels (seed %u)\n", MAX_AUDIO_CHANNELS, seed);
+	return EXIT_SUCCESS;
+}
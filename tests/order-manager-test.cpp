@@ -0,0 +1,160 @@
+#include "order-manager.hpp"
+#include "order-store.hpp"
+#include "uuid-table.hpp"
+
+#include <obs-module.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <future>
+#include <random>
+#include <string>
+#include <system_error>
+
+// Checks that a snapshot the saver fails to write is written again by the next Save(),
+// instead of the changes it carried being dropped until something else marks them dirty,
+// and that unloading idle collections keeps the edits made to them.
+
+OBS_DECLARE_MODULE()
+
+#define SECONDS_PER_DAY 86400
+
+// More than the manager keeps decoded, so selecting each in turn unloads the first ones
+#define COLLECTION_COUNT 5
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char *SOURCE_A = "01234567-89ab-cdef-0123-456789abcdef";
+const char *SOURCE_B = "11234567-89ab-cdef-0123-456789abcdef";
+
+bool fail(const char *what)
+{
+	fprintf(stderr, "%s\n", what);
+	return false;
+}
+
+bool runFailedSnapshotRetry(const fs::path &directory)
+{
+	// The store is written through order.bin.tmp; a directory in its place makes every write fail
+	const fs::path blocker = directory / "order.bin.tmp";
+	fs::create_directories(blocker);
+
+	OrderManager manager(directory.string());
+	manager.Load();
+	manager.SetCurrentCollection("Collection");
+	manager.SetCurrentScene("Scene");
+	manager.AddSource(SOURCE_A);
+	manager.AddSource(SOURCE_B);
+
+	// Cleanup stamps the collection, scene and sources as seen today, which isn't journaled
+	OrderManager::LiveState live;
+	live.sources = {SOURCE_A, SOURCE_B};
+	live.scenes = {"Scene"};
+	live.collections = {"Collection"};
+	std::promise<void> finished;
+	manager.StartReconcile(live, [&finished]() { finished.set_value(); });
+	finished.get_future().wait();
+	if (!manager.FinishReconcile())
+		return fail("Cleanup changed nothing");
+
+	// Writes synchronously and stops the saver; later saves write on this thread
+	manager.Flush();
+	if (fs::exists(directory / "order.bin"))
+		return fail("Snapshot was written despite the blocked path");
+
+	fs::remove_all(blocker);
+	manager.Save();
+
+	OrderStore store;
+	if (!store.Open((directory / "order.bin").string()))
+		return fail("Snapshot was not retried by the next save");
+
+	const uint32_t today = static_cast<uint32_t>(time(nullptr) / SECONDS_PER_DAY);
+	if (store.GetCollectionSeen("Collection") != today)
+		return fail("Retried snapshot lost the cleanup changes");
+
+	UuidTable table;
+	OrderStore::SceneHandles scenes;
+	OrderStore::SeenDays seen;
+	if (!store.ReadCollection("Collection", table, scenes, seen) || scenes["Scene"].size() != 2 ||
+	    seen.scenes["Scene"] != today || seen.ids.size() != 2)
+		return fail("Retried snapshot does not hold the order");
+	return true;
+}
+
+std::string collectionName(int index)
+{
+	return "Collection " + std::to_string(index);
+}
+
+bool checkOrders(OrderManager &manager, const char *when)
+{
+	for (int index = COLLECTION_COUNT - 1; index >= 0; index--) {
+		manager.SetCurrentCollection(collectionName(index));
+		manager.SetCurrentScene("Scene");
+		size_t expected = index == 0 ? 2 : 1;
+		if (manager.GetOrderSize() != expected || manager.GetPosition(SOURCE_A) != 0 ||
+		    (index == 0 && manager.GetPosition(SOURCE_B) != 1)) {
+			fprintf(stderr, "%s, %s has the wrong order\n", when, collectionName(index).c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+bool runIdleCollectionEdits(const fs::path &directory)
+{
+	fs::create_directories(directory);
+
+	{
+		OrderManager manager(directory.string());
+		manager.Load();
+		for (int index = 0; index < COLLECTION_COUNT; index++) {
+			manager.SetCurrentCollection(collectionName(index));
+			manager.SetCurrentScene("Scene");
+			manager.AddSource(SOURCE_A);
+		}
+		manager.Flush();
+	}
+
+	// Collection 0 is edited and then unloaded, along with collections left as they were read
+	OrderManager manager(directory.string());
+	manager.Load();
+	manager.SetCurrentCollection(collectionName(0));
+	manager.SetCurrentScene("Scene");
+	manager.AddSource(SOURCE_B);
+	for (int index = 1; index < COLLECTION_COUNT; index++) {
+		manager.SetCurrentCollection(collectionName(index));
+	}
+	if (!checkOrders(manager, "After unloading"))
+		return false;
+	manager.Flush();
+
+	OrderManager reloaded(directory.string());
+	reloaded.Load();
+	return checkOrders(reloaded, "After reloading");
+}
+
+} // namespace
+
+int main()
+{
+	std::random_device random;
+	const fs::path directory = fs::temp_directory_path() / ("order-manager-test-" + std::to_string(random()));
+	fs::create_directories(directory);
+
+	bool passed = runFailedSnapshotRetry(directory / "retry") && runIdleCollectionEdits(directory / "idle");
+
+	std::error_code error;
+	fs::remove_all(directory, error);
+
+	if (!passed)
+		return EXIT_FAILURE;
+
+	printf("Failed snapshot writes are retried and unloaded collections keep their edits\n");
+	return EXIT_SUCCESS;
+}